@@ -0,0 +1,113 @@
+#include "pch.h"
+
+#include "bench.h"
+#include "lexer/lexer.h"
+#include "parser/parser.h"
+
+// A loop body large enough that its nodes don't fit in cache, so walking it
+// repeatedly is dominated by how the nodes are laid out in memory
+static std::string makeProgram(int statements, int iterations) {
+    std::string source = "DECLARE a, b, c : INTEGER\nDECLARE Arr : ARRAY[1:10] OF INTEGER\n";
+    source += "a <- 1\nb <- 2\nc <- 3\n";
+    source += "FOR i <- 1 TO " + std::to_string(iterations) + "\n";
+    for (int i = 0; i < statements; i++) {
+        switch (i % 4) {
+            case 0: source += "    a <- (b + c * 2 - a) MOD 1000\n"; break;
+            case 1: source += "    Arr[i MOD 10 + 1] <- a + b\n"; break;
+            case 2: source += "    IF a > b AND NOT c = 0 THEN\n        b <- Arr[1] MOD 7\n    ENDIF\n"; break;
+            case 3: source += "    c <- c + 1 - b DIV 3\n"; break;
+        }
+    }
+    source += "NEXT i\n";
+    return source;
+}
+
+// Straight-line code made almost entirely of expressions
+static std::string makeExpressions(int lines) {
+    std::string source = "DECLARE a, b, c : INTEGER\nDECLARE s : STRING\n";
+    for (int i = 0; i < lines; i++) {
+        switch (i % 4) {
+            case 0: source += "a <- (a + b * 2 - c DIV 3) MOD 17 + -b * (c - 1) / 4\n"; break;
+            case 1: source += "OUTPUT a > b AND NOT c = 0 OR a + 1 <= b * 2 AND c <> a\n"; break;
+            case 2: source += "s <- \"n=\" & NUM_TO_STR(a * b + c) & \", m=\" & NUM_TO_STR(a MOD 7)\n"; break;
+            case 3: source += "b <- 1 + 2 + 3 + 4 + 5 + 6 + 7 + 8 + 9 + 10 - a - b - c\n"; break;
+        }
+    }
+    return source;
+}
+
+// A CASE statement whose arms hold many long statements
+static std::string makeCase(int arms) {
+    std::string source = "DECLARE a : INTEGER\nCASE OF a\n";
+    for (int i = 0; i < arms; i++) {
+        source += "    " + std::to_string(i) + ": a <- a + 1 + 2 + 3 + 4 + 5 + 6 + 7 + 8 + 9 + 10 + 11 + 12\n";
+        for (int j = 0; j < 8; j++) {
+            source += "        OUTPUT a, a * 2, a * 3, a * 4, a * 5, a * 6, a * 7, a * 8, a * 9, a * 10\n";
+        }
+    }
+    source += "ENDCASE\n";
+    return source;
+}
+
+// A large library of routines of which the program only calls a couple
+static std::string makeLibrary(int routines) {
+    std::string source;
+    for (int i = 0; i < routines; i++) {
+        std::string n = std::to_string(i);
+        source += "FUNCTION F" + n + "(x : INTEGER) RETURNS INTEGER\n";
+        source += "    DECLARE t : INTEGER\n    t <- x * " + n + " + 1\n";
+        source += "    IF t MOD 2 = 0 THEN\n        t <- t DIV 2\n    ELSE\n        t <- 3 * t + 1\n    ENDIF\n";
+        source += "    RETURN t\nENDFUNCTION\n";
+        source += "PROCEDURE P" + n + "(x : INTEGER)\n";
+        source += "    FOR i <- 1 TO x\n        OUTPUT F" + n + "(i), \" \", x - i\n    NEXT i\nENDPROCEDURE\n";
+    }
+    source += "DECLARE r : INTEGER\nr <- F0(1) + F1(2)\n";
+    return source;
+}
+
+int main() {
+    // Time per byte should stay flat as the number of arms grows
+    for (int arms : {1000, 4000, 16000}) {
+        std::string source = makeCase(arms);
+        Lexer lexer(source);
+        auto tokens = lexer.makeTokens();
+        runBenchmark("parse (CASE, " + std::to_string(arms) + " arms)", source.size(), 5, [&]() {
+            Parser parser(tokens);
+            parser.parse();
+        });
+    }
+
+    std::string expressions = makeExpressions(100000);
+    runBenchmark("parse (expressions)", expressions.size(), 10, [&]() {
+        Lexer lexer(expressions);
+        Parser parser(lexer.makeTokens());
+        parser.parse();
+    });
+
+    // Only the two called functions' bodies should cost anything beyond skipping their tokens
+    std::string library = makeLibrary(20000);
+    Lexer libraryLexer(library);
+    auto libraryTokens = libraryLexer.makeTokens();
+    runBenchmark("parse (library)", library.size(), 10, [&]() {
+        Parser parser(libraryTokens);
+        parser.parse();
+    });
+
+    std::string source = makeProgram(20000, 20);
+
+    runBenchmark("parse (loop body)", source.size(), 10, [&]() {
+        Lexer lexer(source);
+        Parser parser(lexer.makeTokens());
+        parser.parse();
+    });
+
+    Lexer lexer(source);
+    Parser parser(lexer.makeTokens());
+    Interpreter::Block *block = parser.parse();
+    runBenchmark("walk", source.size(), 5, [&]() {
+        Interpreter::Instance instance("bench");
+        auto globalCtx = Interpreter::Context::createGlobalContext(instance);
+        block->run(*globalCtx);
+    });
+    return 0;
+}
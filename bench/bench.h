@@ -0,0 +1,27 @@
+#pragma once
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+// Runs fn `iterations` times and prints the throughput over `bytes` bytes per run
+template<typename Fn>
+void runBenchmark(std::string_view name, size_t bytes, int iterations, Fn &&fn) {
+    fn(); // Warm up
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) fn();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    double seconds = elapsed.count() / iterations;
+    double mbPerSecond = (bytes / (1024.0 * 1024.0)) / seconds;
+    std::cout << name << ": " << seconds * 1000 << " ms/run, " << mbPerSecond << " MB/s" << std::endl;
+}
+
+// Repeats `unit` until the result is at least `bytes` long
+inline std::string repeatSource(std::string_view unit, size_t bytes) {
+    std::string source;
+    source.reserve(bytes + unit.size());
+    while (source.size() < bytes) source += unit;
+    return source;
+}
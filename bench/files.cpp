@@ -0,0 +1,78 @@
+#include "pch.h"
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "bench.h"
+#include "interpreter/file.h"
+#include "interpreter/readAhead.h"
+
+int main() {
+    std::string path = "/tmp/pe2-readfile.log";
+    std::string contents = repeatSource("2024-01-01 12:00:00 INFO request handled in 12 ms by worker 3\n", 64 << 20);
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << contents;
+    }
+
+    size_t lines = 0;
+    runBenchmark("READFILE (64 MB)", contents.size(), 5, [&]() {
+        Interpreter::File file(Interpreter::String(path), Interpreter::FileMode::READ);
+        Interpreter::String line;
+        while (!file.eof()) {
+            line.value = file.read();
+            lines++;
+        }
+    });
+    std::cout << "    " << lines / 6 << " lines" << std::endl;
+
+    // What READFILE gets from PSEUDOENGINE2_READ_AHEAD: chunks read on another thread while lines are split
+    runBenchmark("read-ahead (64 MB)", contents.size(), 5, [&]() {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        {
+            Interpreter::ReadAhead reader(fd, 4, 1 << 20);
+            for (std::string_view chunk = reader.next(); !chunk.empty(); chunk = reader.next()) {
+                for (size_t end = chunk.find('\n'); end != std::string_view::npos; end = chunk.find('\n', end + 1)) {
+                    lines++;
+                }
+                reader.release();
+            }
+        }
+        ::close(fd);
+    });
+
+    std::string output = "/tmp/pe2-writefile.txt";
+    runBenchmark("WRITEFILE (64 MB)", contents.size(), 5, [&]() {
+        Interpreter::File file(Interpreter::String(output), Interpreter::FileMode::WRITE);
+        std::string_view rest = contents;
+        while (!rest.empty()) {
+            size_t end = rest.find('\n');
+            file.write(rest.substr(0, end));
+            rest.remove_prefix(end + 1);
+        }
+    });
+
+    // Records are read back in a scattered order, each one costing a single pread
+    std::string records = "/tmp/pe2-records.dat";
+    constexpr size_t recordSize = 64, recordCount = 1 << 20;
+    {
+        Interpreter::File file(Interpreter::String(records), Interpreter::FileMode::RANDOM);
+        file.setRecordSize(recordSize);
+        char record[recordSize] = {};
+        for (size_t i = 0; i < recordCount; i++) file.putRecord(record);
+    }
+    runBenchmark("GETRECORD (64 MB, scattered)", recordSize * recordCount, 5, [&]() {
+        Interpreter::File file(Interpreter::String(records), Interpreter::FileMode::RANDOM);
+        file.setRecordSize(recordSize);
+        char record[recordSize];
+        for (size_t i = 0; i < recordCount; i++) {
+            file.seek(i * 7919 % recordCount);
+            file.getRecord(record);
+        }
+    });
+
+    std::remove(records.c_str());
+    std::remove(output.c_str());
+    std::remove(path.c_str());
+    return 0;
+}
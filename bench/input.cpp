@@ -0,0 +1,38 @@
+#include "pch.h"
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "bench.h"
+#include "interpreter/input.h"
+#include "interpreter/types/types.h"
+
+int main() {
+    std::string numbers;
+    unsigned long state = 12345;
+    for (int i = 0; i < 1000000; i++) {
+        state = state * 6364136223846793005ul + 1442695040888963407ul;
+        numbers += std::to_string(static_cast<long>(state >> 34) - (1l << 29));
+        numbers += i % 2 == 0 ? "\n" : ".25\n";
+    }
+
+    char path[] = "/tmp/pe2-input-XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0 || write(fd, numbers.data(), numbers.size()) != static_cast<ssize_t>(numbers.size())) return 1;
+
+    double sum = 0;
+    runBenchmark("INPUT (1000000 numbers)", numbers.size(), 10, [&]() {
+        lseek(fd, 0, SEEK_SET);
+        Interpreter::InputReader reader(fd);
+        std::string_view line;
+        for (bool integer = true; reader.readLine(line); integer = !integer) {
+            if (integer) sum += Interpreter::String::parseInteger(line);
+            else sum += Interpreter::String::parseReal(line);
+        }
+    });
+    std::cout << "    checksum " << sum << std::endl;
+
+    close(fd);
+    std::remove(path);
+    return 0;
+}
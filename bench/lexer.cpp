@@ -0,0 +1,66 @@
+#include "pch.h"
+
+#include "bench.h"
+#include "lexer/lexer.h"
+#include "launch/cache.h"
+
+static const std::string_view mixedUnit =
+    "DECLARE Total, Index : INTEGER\n"
+    "Total <- 0\n"
+    "FOR Index <- 1 TO 100 STEP 2\n"
+    "    IF Index MOD 3 = 0 AND NOT Total > 1000 THEN\n"
+    "        Total <- Total + Index * 2 // accumulate\n"
+    "    ELSE\n"
+    "        OUTPUT \"Index \", Index, \" skipped\\n\", 'c', 3.14159\n"
+    "    ENDIF\n"
+    "NEXT Index\n";
+
+static const std::string_view identifierUnit =
+    "alpha <- beta + gamma * delta - epsilon / zeta\n"
+    "someLongVariableName <- anotherLongVariableName & yetAnotherName\n"
+    "result[rowIndex, columnIndex] <- matrix[columnIndex, rowIndex]\n";
+
+static const std::string_view commentUnit =
+    "            // Generated question bank entry, the answer is checked against the expected output below\n"
+    "            OUTPUT \"The quick brown fox jumps over the lazy dog while the lexer scans the string\"\n"
+    "                    // ---------------------------------------------------------------------\n";
+
+static void benchLexer(std::string_view name, std::string_view unit, size_t bytes) {
+    std::string source = repeatSource(unit, bytes);
+    size_t tokenCount = 0;
+    runBenchmark(name, source.size(), 10, [&]() {
+        Lexer lexer(source);
+        tokenCount = lexer.makeTokens().size();
+    });
+    std::cout << "    " << tokenCount << " tokens" << std::endl;
+}
+
+static void benchCache(std::string_view name, std::string_view unit, size_t bytes) {
+    std::string source = repeatSource(unit, bytes);
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "pseudoengine2-bench-cache";
+    std::filesystem::create_directories(directory);
+    // Entries are keyed by the source file's path and modification time, so it has to exist
+    std::filesystem::path filename = directory / "source.pseudo";
+    std::ofstream(filename, std::ios::binary) << source;
+    {
+        Lexer lexer(source);
+        TokenCache(filename, directory).store(source, lexer.makeTokens());
+    }
+
+    size_t tokenCount = 0;
+    runBenchmark(name, source.size(), 10, [&]() {
+        TokenCache cache(filename, directory);
+        tokenCount = cache.load(source).size();
+    });
+    std::cout << "    " << tokenCount << " tokens" << std::endl;
+    std::filesystem::remove_all(directory);
+}
+
+int main() {
+    constexpr size_t size = 8 * 1024 * 1024;
+    benchLexer("lexer (mixed)", mixedUnit, size);
+    benchLexer("lexer (identifiers)", identifierUnit, size);
+    benchLexer("lexer (comments and strings)", commentUnit, size);
+    benchCache("token cache load (mixed)", mixedUnit, size);
+    return 0;
+}
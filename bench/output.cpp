@@ -0,0 +1,41 @@
+#include "pch.h"
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "bench.h"
+#include "lexer/lexer.h"
+#include "parser/parser.h"
+#include "interpreter/output.h"
+
+// Runs source with its output going to /dev/null, reporting throughput over bytes of output
+static void benchOutput(std::string_view name, const std::string &source, size_t bytes) {
+    Lexer lexer(source);
+    Parser parser(lexer.makeTokens());
+    Interpreter::Block *block = parser.parse();
+
+    int null = open("/dev/null", O_WRONLY);
+    int results = dup(1);
+    runBenchmark(name, bytes, 5, [&]() {
+        // Only the program's output goes to /dev/null
+        dup2(null, 1);
+        {
+            Interpreter::OutputBuffer output;
+            Interpreter::Instance instance("bench");
+            auto globalCtx = Interpreter::Context::createGlobalContext(instance);
+            block->run(*globalCtx);
+        }
+        dup2(results, 1);
+    });
+    close(null);
+    close(results);
+}
+
+int main() {
+    size_t bytes = 0;
+    for (int i = 1; i <= 1000000; i++) bytes += std::to_string(i).size() + 16;
+    benchOutput("OUTPUT (1000000 lines)", "FOR i <- 1 TO 1000000\n    OUTPUT \"line \", i, \" of output\"\nNEXT i\n", bytes);
+
+    // Mostly 17 significant digits, the slowest case for shortest round-trip formatting
+    benchOutput("OUTPUT (1000000 reals)", "FOR i <- 1 TO 1000000\n    OUTPUT i / 7\nNEXT i\n", 1000000 * 19);
+    return 0;
+}
@@ -5,6 +5,7 @@
 #include <concepts>
 #include "interpreter/types/types.h"
 #include "interpreter/variable.h"
+#include "interpreter/arrayFile.h"
 
 namespace Interpreter {
     struct ArrayDimension {
@@ -25,6 +26,8 @@ namespace Interpreter {
     class Array : public DataHolder {
     private:
         std::vector<std::unique_ptr<Variable>> data;
+        // Set for PERSISTENT arrays, written back on destruction
+        std::unique_ptr<ArrayFile> file;
 
         static const std::vector<ArrayDimension> copyDimensions(const std::vector<ArrayDimension> &source);
 
@@ -36,6 +39,8 @@ namespace Interpreter {
 
         Array(const Array &other);
 
+        ~Array();
+
         void copyData(const Array &other);
 
         constexpr bool isArray() const override {return true;}
@@ -44,5 +49,14 @@ namespace Interpreter {
         void init(Context &ctx);
 
         Variable &getElement(const std::vector<int_t> &index);
+
+        // Element at a position in storage order, where the first index changes fastest
+        Variable &getElementAt(size_t position);
+
+        size_t getSize() const;
+
+        // Keeps the elements in file from now on, loading them from it unless it was just created.
+        // Returns false, without attaching the file, if it doesn't hold valid elements.
+        bool persist(std::unique_ptr<ArrayFile> &&arrayFile, bool load, Context &ctx);
     };
 };
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <string>
+
+namespace Interpreter {
+    // File a PERSISTENT array is saved in, in the record layout of RANDOM files. The whole file is read into memory
+    // when the array is declared and written out again when it goes out of scope, it is never mapped or updated in place
+    class ArrayFile {
+    private:
+        std::filesystem::path path;
+        std::string buffer;
+
+    public:
+        enum class Status {
+            CREATED, OPENED, FAILED, WRONG_SIZE
+        };
+
+        ArrayFile() = default;
+
+        ArrayFile(const ArrayFile&) = delete;
+
+        ArrayFile &operator=(const ArrayFile&) = delete;
+
+        // Reads the file, which is treated as size zero bytes if it doesn't exist or is empty. Existing files must be size bytes
+        Status open(const std::filesystem::path &filename, size_t size);
+
+        char *data();
+
+        // Replaces the file with the contents, so it is never left half written
+        bool save();
+    };
+}
@@ -2,7 +2,8 @@
 #include "interpreter/procedure.h"
 
 namespace Interpreter {
-    static Token errToken{TokenType::FUNCTION, 0, 0};
+    // Call of the builtin function running in ctx, which its errors point to
+    const Token &callToken(const Context &ctx);
 
     struct BuiltinFnLength : public Function {
         BuiltinFnLength();
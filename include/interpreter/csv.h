@@ -0,0 +1,40 @@
+#pragma once
+#include <deque>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "interpreter/variable.h"
+
+namespace Interpreter {
+    // Splits comma separated text into rows of fields. Fields can be quoted with '"', doubling any quotes
+    // inside them, to hold commas and newlines. Blank lines are skipped and "\r\n" line endings accepted.
+    class CsvReader {
+    private:
+        std::string_view text;
+        size_t position = 0;
+        int line = 1, rowLine = 0;
+
+        std::vector<std::string_view> fields;
+        // Quoted fields containing doubled quotes, a deque so adding one never moves the others
+        std::deque<std::string> unescaped;
+
+        std::string_view readQuoted(size_t fieldIdx);
+
+    public:
+        explicit CsvReader(std::string_view text);
+
+        // Moves to the next row, false at the end of the text
+        bool next();
+
+        // Fields of the current row, valid until the next call to next()
+        std::span<const std::string_view> row() const;
+
+        // Line of the text the current row starts on, counted from 1
+        int getLine() const;
+
+        // Converts field to var's type and stores it, false if it isn't a valid value of that type.
+        // Spaces around fields are ignored for all types but STRING.
+        static bool setValue(Variable &var, std::string_view field, Context &ctx);
+    };
+}
@@ -18,9 +18,10 @@ namespace Interpreter {
     public:
         Error(const Token &token, const std::string &info = "");
 
-        virtual std::string toStr() const;
+        // Describes the error in the program named filename
+        virtual std::string toStr(std::string_view filename) const;
 
-        void print(std::ostream &os = std::cerr) const;
+        void print(std::ostream &os, std::string_view filename) const;
     };
 
 
@@ -55,6 +56,7 @@ namespace Interpreter {
 
     class RuntimeError : public Error {
     private:
+        // Info and traceback, made when thrown since the contexts are gone by the time it is printed
         std::string rtInfo;
 
     public:
@@ -62,7 +64,7 @@ namespace Interpreter {
 
         RuntimeError(const Token &token, const Context &context, const std::string &info = "");
 
-        std::string toStr() const override;
+        std::string toStr(std::string_view filename) const override;
     };
 
     class InvalidUsageError : public RuntimeError {
@@ -4,20 +4,44 @@
 #include <iostream>
 #include <fstream>
 #include <memory>
+#include <cstdint>
+#include <chrono>
+#include <string_view>
 #include "interpreter/types/types.h"
+#include "interpreter/input.h"
 
 namespace Interpreter {
+    class ReadAhead;
+
     enum class FileMode {
-        READ, WRITE, APPEND
+        READ, WRITE, APPEND, RANDOM
     };
 
     class File {
     private:
         FileMode mode;
-        std::unique_ptr<std::ofstream> ofile;
-        std::unique_ptr<std::ifstream> ifile;
+
+        // Files opened for WRITE or APPEND collect lines in a buffer, written out when full and on close
+        int fd = -1;
+        std::string buffer;
+        std::chrono::steady_clock::time_point lastSync;
+        // Files opened for READ are read a chunk at a time as lines are asked for
+        std::unique_ptr<InputReader> reader;
+        // Unless PSEUDOENGINE2_READ_AHEAD has them read on a background thread, handed over a chunk at a time
+        std::unique_ptr<ReadAhead> prefetch;
+        std::string_view chunk;
+        bool chunkHeld = false, chunkEnded = false;
+        std::string carry;
+        // Files opened for RANDOM hold fixed size records, sized by the first GETRECORD or PUTRECORD
+        size_t recordSize = 0;
+        uint64_t record = 0;
         bool open = true;
 
+        uint64_t size();
+
+        // Makes sure chunk has unread data, false at the end of the file
+        bool nextChunk();
+
     public:
         const String name;
         
@@ -31,20 +55,58 @@ namespace Interpreter {
 
         void close();
 
-        String read();
+        // Reads the next line without its newline, the view is valid until the next read or eof()
+        std::string_view read();
+
+        // Writes data followed by a newline
+        void write(std::string_view data);
+
+        // Writes out buffered lines, also syncing them to disk if PSEUDOENGINE2_FSYNC asks for it
+        void flush(bool closing = false);
+
+        // Moves to a record, counted from 0
+        void seek(uint64_t index);
+
+        // Fixes the record size on first use, false if size differs from it
+        bool setRecordSize(size_t size);
 
-        void write(const String &data);
+        // Reads the current record and moves to the next one, false if the file ends before a whole record
+        bool getRecord(char *data);
+
+        // Writes the current record and moves to the next one, false on write errors
+        bool putRecord(const char *data);
     };
 
+    // Open files, kept in numbered slots (handles) found by name through an open addressing table.
+    // Statements working on files also remember the handle they used last, indexed by a site id the parser numbers them with.
     class FileManager {
     private:
         std::vector<std::unique_ptr<File>> files;
-    
+        std::vector<size_t> freeHandles;
+
+        // Handles of open files, or `empty`, at the position their name hashes to or just after it
+        static constexpr size_t empty = SIZE_MAX;
+        std::vector<size_t> table;
+        size_t openFiles = 0;
+
+        // Handle last resolved at each site, possibly stale
+        std::vector<size_t> siteHandles;
+
+        size_t findSlot(std::string_view name) const;
+
+        void grow();
+
+        File *lookup(std::string_view name);
+
     public:
         bool createFile(const String &name, FileMode mode);
 
         File *getFile(const String &name);
 
+        // Same as getFile(name), first trying the file the same site used last. Sites from different parsers,
+        // such as REPL lines, may share ids, which only costs a lookup since the file name is checked
+        File *getFile(const String &name, size_t site);
+
         void closeFile(const String &name);
     };
 }
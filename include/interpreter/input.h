@@ -0,0 +1,38 @@
+#pragma once
+#include <iosfwd>
+#include <string_view>
+#include <vector>
+
+namespace Interpreter {
+    // Reads stdin, or a file opened for READ, in large chunks, handing out lines as views into its buffer
+    class InputReader {
+    private:
+        int fd;
+        // Flushed before reading, since what is waiting to be output may be a prompt for the input
+        std::ostream *tied;
+        std::vector<char> buffer;
+        // Unread data is buffer[start, end)
+        size_t start = 0;
+        size_t end = 0;
+        bool eof = false;
+
+        // Reads more data after what is left unread, returning false once nothing more can be read
+        bool fill();
+
+    public:
+        explicit InputReader(int fd, std::ostream *tied = nullptr);
+
+        InputReader(const InputReader&) = delete;
+        InputReader &operator=(const InputReader&) = delete;
+
+        // Reader of stdin, tied to std::cout, used by INPUT and the REPL unless given another
+        static InputReader &shared();
+
+        // Reads the next line without its newline, the view is only valid until the next call.
+        // Returns false with an empty line at the end of the input.
+        bool readLine(std::string_view &line);
+
+        // True once everything has been read, reading more if nothing is left in the buffer
+        bool atEnd();
+    };
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include "interpreter/input.h"
+#include "interpreter/types/types.h"
+
+namespace Interpreter {
+    class Error;
+
+    // State of one running program, or REPL session, that would otherwise be shared by the whole process:
+    // where its output goes and its input comes from, its random numbers and the name its errors are
+    // reported under. Programs with their own instances and global contexts can run on separate threads.
+    class Instance {
+    private:
+        std::string filename;
+        bool repl;
+        std::ostream &output, &errors;
+        InputReader &input;
+        size_t maxCallDepth = 0;
+
+        std::mt19937_64 random;
+        // PARALLEL FOR iterations can call RAND at the same time
+        std::mutex randomMutex;
+
+    public:
+        Instance(const std::string &filename, bool repl = false, std::ostream &output = std::cout,
+            std::ostream &errors = std::cerr, InputReader &input = InputReader::shared());
+
+        Instance(const Instance&) = delete;
+        Instance &operator=(const Instance&) = delete;
+
+        const std::string &getFilename() const;
+
+        // REPL sessions output the value of every expression run on its own
+        bool isREPL() const;
+
+        std::ostream &getOutput();
+
+        std::ostream &getErrors();
+
+        InputReader &getInput();
+
+        // Deepest calls can nest before raising a runtime error, 0 for no limit. Programs sharing a process with others
+        // get a limit so endless recursion fails on its own instead of overflowing the stack and ending every program
+        size_t getMaxCallDepth() const;
+
+        void setMaxCallDepth(size_t depth);
+
+        // Random number in [0, limit)
+        real_t getRandom(real_t limit);
+
+        // Prints error after anything already output
+        void report(const Error &error);
+    };
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <streambuf>
+#include <string>
+
+namespace Interpreter {
+    // Buffers everything written to std::cout while it exists, instead of writing each line separately.
+    // The buffer is written out when full, when std::cout is flushed (std::cin and std::cerr are tied
+    // to it, so before reading input and printing errors) and when it is destroyed. If stdout is a
+    // terminal it is also written out at the end of every line.
+    class OutputBuffer : public std::streambuf {
+    private:
+        std::string buffer;
+        bool lineBuffered;
+        std::streambuf *previous;
+
+        bool flush();
+
+    protected:
+        int_type overflow(int_type c) override;
+
+        std::streamsize xsputn(const char *s, std::streamsize n) override;
+
+        int sync() override;
+
+    public:
+        OutputBuffer();
+
+        ~OutputBuffer();
+
+        OutputBuffer(const OutputBuffer&) = delete;
+        OutputBuffer &operator=(const OutputBuffer&) = delete;
+    };
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace Interpreter {
+    // Reads a file on a background thread into a ring of buffers, handed to a single consumer in order.
+    // The ring is a lock-free single producer, single consumer queue; each side only blocks when it's full or empty.
+    class ReadAhead {
+    private:
+        struct Chunk {
+            std::unique_ptr<char[]> data;
+            size_t size = 0;
+        };
+
+        const int fd;
+        const size_t chunkSize;
+        std::vector<Chunk> ring;
+
+        // Chunks filled and given back so far, the ring holds the chunks in between
+        std::atomic<size_t> produced = 0;
+        std::atomic<size_t> consumed = 0;
+        std::atomic<bool> stopping = false;
+
+        std::thread producer;
+
+        void produce();
+
+    public:
+        // Starts reading fd, which must stay open until the ReadAhead is destroyed
+        ReadAhead(int fd, size_t chunks, size_t chunkSize);
+
+        ~ReadAhead();
+
+        ReadAhead(const ReadAhead&) = delete;
+        ReadAhead &operator=(const ReadAhead&) = delete;
+
+        // Waits for the next chunk, empty at the end of the file. It stays valid until release()
+        std::string_view next();
+
+        // Hands the chunk returned by next() back to the producer
+        void release();
+    };
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include <cstddef>
+#include "interpreter/variable.h"
+
+namespace Interpreter {
+    // Binary layout of the records in RANDOM files, in the machine's byte order. INTEGER and REAL take 8 bytes,
+    // BOOLEAN and CHAR 1, DATE 4 (16 bit year, month and day), ENUM 4 (index of the value) and STRING 256
+    // (16 bit length followed by up to 254 characters). Composites store their members in declaration order.
+    namespace Record {
+        constexpr size_t maxStringLength = 254;
+
+        // Bytes taken by var, 0 if it can't be stored (pointers and composites containing arrays)
+        size_t size(Variable &var);
+
+        // Writes var to record, false if a STRING is longer than maxStringLength
+        bool store(Variable &var, char *record);
+
+        // Sets var from record, false if the record doesn't hold a valid value of var's type
+        bool load(Variable &var, const char *record, Context &ctx);
+    }
+}
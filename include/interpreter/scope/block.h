@@ -1,12 +1,12 @@
 #pragma once
-#include <vector>
+#include <span>
 #include "interpreter/scope/context.h"
 #include "nodes/base.h"
 
 namespace Interpreter {
     class Block {
     private:
-        std::vector<Node*> nodes;
+        const std::span<Node *const> nodes;
 
         void runNodeREPL(Node *node, Interpreter::Context &ctx);
 
@@ -15,15 +15,17 @@ namespace Interpreter {
         void _runREPL(Interpreter::Context &ctx);
 
     public:
-        virtual ~Block() = default;
+        Block(std::span<Node *const> nodes);
 
-        void addNode(Node *node);
+        virtual ~Block() = default;
 
         virtual void run(Interpreter::Context &ctx);
     };
 
     class MainBlock final : public Block {
     public:
+        using Block::Block;
+
         void run(Interpreter::Context &ctx) override;
     };
 }
@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
 #include "lexer/tokens.h"
@@ -8,6 +9,7 @@
 #include "interpreter/procedure.h"
 #include "nodes/nodeResult.h"
 #include "interpreter/file.h"
+#include "interpreter/instance.h"
 
 namespace Interpreter {
     class Context {
@@ -22,6 +24,13 @@ namespace Interpreter {
         std::vector<std::unique_ptr<PointerTypeDefinition>> pointers;
         std::vector<std::unique_ptr<CompositeTypeDefinition>> composites;
         std::unique_ptr<FileManager> fileManager;
+        Instance *instance;
+        // Number of contexts this one is nested in
+        size_t depth;
+        // Frames look up what they don't declare in their parent instead of the global context
+        bool isFrame = false;
+
+        Context *getLookupContext();
 
     public:
         const Token *switchToken = nullptr;
@@ -44,35 +53,45 @@ namespace Interpreter {
         // Only for composites
         void copyVariableData(const Context &other);
 
-        static std::unique_ptr<Context> createGlobalContext();
+        // Only for composites, members in declaration order
+        const std::vector<std::unique_ptr<Variable>> &getVariables() const;
+
+        bool hasArrays() const;
+
+        static std::unique_ptr<Context> createGlobalContext(Instance &instance);
+
+        // Private scope for one iteration of a PARALLEL FOR loop
+        static std::unique_ptr<Context> createFrame(Context &parent, const std::string &name);
 
         Context *getParent() const;
 
+        size_t getDepth() const;
+
         Context *getGlobalContext();
 
         const std::string &getName() const;
 
         void addVariable(Variable *variable);
 
-        Variable *getVariable(const std::string &varName, bool global = true);
+        Variable *getVariable(std::string_view varName, bool global = true);
 
         void addProcedure(std::unique_ptr<Procedure> &&procedure);
 
-        Procedure *getProcedure(const std::string &procedureName);
+        Procedure *getProcedure(std::string_view procedureName);
 
         void addFunction(std::unique_ptr<Function> &&function);
 
-        Function *getFunction(const std::string &functionName);
+        Function *getFunction(std::string_view functionName);
 
         void addArray(std::unique_ptr<Array> &&array);
 
-        Array *getArray(const std::string &arrayName, bool global = true);
+        Array *getArray(std::string_view arrayName, bool global = true);
 
         Interpreter::DataType getType(const Token &token, bool global = true);
 
         bool isIdentifierType(const Token &identifier, bool global = true);
 
-        Enum *getEnumElement(const std::string &value, bool global = true);
+        Enum *getEnumElement(std::string_view value, bool global = true);
 
         void createEnumDefinition(EnumTypeDefinition &&definition);
 
@@ -80,12 +99,15 @@ namespace Interpreter {
 
         void createCompositeDefinition(CompositeTypeDefinition &&definition);
 
-        const EnumTypeDefinition *getEnumDefinition(const std::string &name, bool global = true);
+        const EnumTypeDefinition *getEnumDefinition(std::string_view name, bool global = true);
 
-        const PointerTypeDefinition *getPointerDefinition(const std::string &name, bool global = true);
+        const PointerTypeDefinition *getPointerDefinition(std::string_view name, bool global = true);
 
-        const CompositeTypeDefinition *getCompositeDefinition(const std::string &name, bool global = true);
+        const CompositeTypeDefinition *getCompositeDefinition(std::string_view name, bool global = true);
     
         FileManager &getFileManager();
+
+        // Instance running the program this context belongs to
+        Instance &getInstance() const;
     };
 }
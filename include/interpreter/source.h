@@ -0,0 +1,41 @@
+#pragma once
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace Interpreter {
+    // Read-only contents of a program's source file. Regular files are memory mapped and used in place, anything that
+    // can't be mapped (pipes, standard input, platforms without mmap) is read into memory
+    class SourceFile {
+    private:
+        const char *mapping = nullptr;
+        size_t mappingSize = 0;
+        std::string buffer;
+        std::string_view contents;
+
+        bool map(const std::filesystem::path &filename);
+
+        bool read(std::istream &stream);
+
+    public:
+        SourceFile() = default;
+
+        SourceFile(const SourceFile&) = delete;
+
+        SourceFile &operator=(const SourceFile&) = delete;
+
+        ~SourceFile();
+
+        // Loads the file, "-" reads the program from standard input. Returns false if it can't be read
+        bool open(const std::filesystem::path &filename);
+
+        // Same as open() without treating "-" specially
+        bool load(const std::filesystem::path &filename);
+
+        // Same as load() but never maps the file. Used for data files, which another process may truncate while
+        // they're in use, turning reads from a mapping into a SIGBUS
+        bool copy(const std::filesystem::path &filename);
+
+        std::string_view view() const;
+    };
+}
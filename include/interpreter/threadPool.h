@@ -0,0 +1,54 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Interpreter {
+    // Fixed set of worker threads that run batches of independent tasks
+    class ThreadPool {
+    private:
+        std::vector<std::thread> workers;
+
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable finished;
+
+        // Only one batch runs at a time, anything else started meanwhile runs on its caller's thread
+        std::mutex batchMutex;
+
+        const std::function<void(size_t)> *task = nullptr;
+        size_t count = 0;
+        std::atomic<size_t> next = 0;
+        std::vector<std::exception_ptr> errors;
+        size_t busyWorkers = 0;
+        unsigned long generation = 0;
+        bool stopping = false;
+
+        void work();
+
+        void runTasks();
+
+    public:
+        explicit ThreadPool(size_t threads);
+
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool &operator=(const ThreadPool&) = delete;
+
+        // Pool shared by the whole interpreter, sized from PSEUDOENGINE2_THREADS or the number of cores
+        static ThreadPool &shared();
+
+        // Number of threads a batch is spread over, including the calling thread
+        size_t concurrency() const;
+
+        // Calls task(i) for every i below count and waits for all of them. If any throw,
+        // the exception of the lowest failing index is rethrown once all tasks are done.
+        void run(size_t count, const std::function<void(size_t)> &task);
+    };
+}
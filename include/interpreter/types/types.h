@@ -1,6 +1,7 @@
 #pragma once
 #include <cstddef>
 #include <string>
+#include <string_view>
 #include <memory>
 #include <chrono>
 
@@ -129,6 +130,13 @@ namespace Interpreter {
         std::unique_ptr<Char> toChar() const override;
 
         std::unique_ptr<String> toString() const override;
+
+        // Enough for any value written by format()
+        static constexpr size_t formatSize = 32;
+
+        // Writes the shortest text that reads back as value, returning its length. Whole numbers get a
+        // trailing ".0" with pointZero set, as OUTPUT prints them, and none otherwise, as NUM_TO_STR does.
+        static size_t format(real_t value, char *buffer, bool pointZero);
     };
 
     class Boolean : public Primitive {
@@ -210,6 +218,11 @@ namespace Interpreter {
         std::unique_ptr<Char> toChar() const override;
 
         std::unique_ptr<String> toString() const override;
+
+        // Conversions used by toInteger() and toReal(), giving 0 unless all of str is a number
+        static int_t parseInteger(std::string_view str);
+
+        static real_t parseReal(std::string_view str);
     };
 
     class Date : public Primitive {
@@ -291,7 +304,7 @@ namespace Interpreter {
 
         void operator=(const Composite &other);
 
-        DataHolder *getMember(const std::string &name);
+        DataHolder *getMember(std::string_view name);
 
         const CompositeTypeDefinition &getDefinition(Context &ctx) const;
     };
@@ -0,0 +1,51 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "lexer/tokens.h"
+
+// Keeps the tokens of a program on disk so repeated runs of the same file can skip the lexer. It is only a lexer cache,
+// programs are still parsed every run. Entries are named by a hash of the file's path and the interpreter version, and
+// like Python's .pyc files are only used while the file has the size and modification time it had when they were made.
+class TokenCache {
+private:
+    std::string sourcePath;
+    int64_t modified = 0;
+    uint64_t key = 0;
+    std::filesystem::path path;
+
+    // The loaded cache file, either memory mapped or read into `buffer` where mmap isn't available
+    const char *data = nullptr;
+    size_t size = 0;
+    std::string buffer;
+
+    std::vector<Token> tokens;
+
+    bool map();
+
+    void unmap();
+
+public:
+    // Looks up the file's modification time, so it must be made before the file is read. An empty directory disables
+    // the cache, as does "-" for a program read from standard input
+    TokenCache(const std::filesystem::path &filename, const std::filesystem::path &directory);
+
+    TokenCache(const TokenCache&) = delete;
+
+    TokenCache &operator=(const TokenCache&) = delete;
+
+    ~TokenCache();
+
+    // The directory named by the PSEUDOENGINE2_CACHE_DIR environment variable, or empty if it isn't set
+    static std::filesystem::path defaultDirectory();
+
+    // Returns the cached tokens for the file's contents, or an empty span if there is no valid entry.
+    // Token values point into the source or the mapped file, so both must outlive their use
+    std::span<const Token> load(std::string_view source);
+
+    // Saves tokens made from the file's contents by the lexer. The cache is only an optimisation, so failures are ignored
+    void store(std::string_view source, std::span<const Token> lexedTokens);
+};
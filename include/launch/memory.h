@@ -0,0 +1,28 @@
+#pragma once
+#include <cstddef>
+
+// Follows the heap memory allocated and freed by the thread that creates it, for as long as it exists.
+// Only counts allocations whose size the C library can report, elsewhere supported() is false.
+// Counts are per thread, so they are approximate: a PARALLEL FOR running on other threads isn't counted,
+// and a block freed on a different thread from the one that allocated it is taken off that thread's count instead.
+class MemoryTracker {
+private:
+    MemoryTracker *previous;
+    long long current = 0, highest = 0;
+
+    friend void trackAllocation(long long change);
+
+public:
+    MemoryTracker();
+
+    ~MemoryTracker();
+
+    MemoryTracker(const MemoryTracker&) = delete;
+
+    MemoryTracker &operator=(const MemoryTracker&) = delete;
+
+    // Most memory that was allocated at once since the tracker was created, in bytes
+    size_t peak() const;
+
+    static bool supported();
+};
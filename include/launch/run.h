@@ -2,7 +2,47 @@
 #include "lexer/lexer.h"
 #include "parser/parser.h"
 #include <filesystem>
+#include <optional>
+#include "launch/cache.h"
+#include "interpreter/source.h"
+#include "interpreter/instance.h"
 
-bool runFile(std::filesystem::path &filename);
+// A program's source, tokens and nodes. Once loaded it can be run any number of times, including at once on
+// several threads, since running a program only changes its global context and never the nodes themselves
+class Program {
+private:
+    Interpreter::SourceFile source;
+    Lexer lexer;
+    std::optional<TokenCache> cache;
+    Parser parser;
+    Interpreter::Block *block = nullptr;
+
+public:
+    Program() = default;
+
+    Program(const Program&) = delete;
+
+    Program &operator=(const Program&) = delete;
+
+    // Reads, lexes and parses filename, reporting any error to instance
+    bool load(const std::filesystem::path &filename, Interpreter::Instance &instance);
+
+    // Runs the program in a new global context, with its input, output and errors going where instance says
+    bool run(Interpreter::Instance &instance);
+
+    // Parses the bodies of routines the runs so far never called, reporting the first syntax error in them to instance
+    bool check(Interpreter::Instance &instance);
+};
+
+// Loads and runs the program in filename, then checks the routines it didn't call
+bool runFile(const std::filesystem::path &filename, Interpreter::Instance &instance);
 
 bool startREPL();
+
+// Runs every program listed in manifest, several at once, and writes how each went to results as CSV.
+// Returns false unless all of them ran without errors and matched any expected output.
+bool runBatch(const std::filesystem::path &manifest, const std::filesystem::path &results);
+
+// Parses the program in filename once, then runs it once for each file in directory, several at once,
+// with that file as input and its output written next to it in <file>.out
+bool runInputs(const std::filesystem::path &filename, const std::filesystem::path &directory);
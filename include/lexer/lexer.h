@@ -1,5 +1,8 @@
 #pragma once
 #include <string>
+#include <string_view>
+#include <span>
+#include <deque>
 #include <vector>
 #include <memory>
 #include "lexer/tokens.h"
@@ -7,16 +10,32 @@
 
 class Lexer {
 private:
-    const std::string *expr;
-    std::vector<std::unique_ptr<Token>> tokens;
+    // Source text, must outlive the tokens as their values point into it
+    std::string_view expr;
+
+    // Tokens from each call of makeTokens() are stored contiguously in their own buffer
+    std::deque<std::vector<Token>> tokenBuffers;
+    std::vector<Token> *tokens = nullptr;
+
+    // Storage for string and char literals containing escape sequences
+    std::deque<std::string> literals;
+
+    // Literals of the lexers used for each chunk of a source lexed in parallel
+    std::deque<std::deque<std::string>> chunkLiterals;
 
     char currentChar;
     int line;
-    int column;
+    // Index of the first character on the current line, columns are computed from it when a token is made
+    size_t lineStart;
     size_t idx;
 
+    int column() const;
+
     void advance();
 
+    // Moves to newIdx, which must not be past a newline that hasn't been visited by advance()
+    void jump(size_t newIdx);
+
     void makeWord();
 
     void makeNumber();
@@ -27,12 +46,18 @@ private:
 
     char getNextChar(size_t n);
 
+    void lex();
+
+    // Lexes a large source in chunks starting at top-level routines, one chunk per task on the shared thread pool.
+    // Returns false if any chunk failed, in which case the source has to be lexed serially to get the right error.
+    bool lexParallel();
+
 public:
     Lexer() = default;
 
-    Lexer(std::string *expr);
+    Lexer(std::string_view expr);
 
-    void setExpr(std::string *_expr);
+    void setExpr(std::string_view _expr);
 
-    const std::vector<Token*> makeTokens();
+    std::span<const Token> makeTokens();
 };
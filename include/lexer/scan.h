@@ -0,0 +1,13 @@
+#pragma once
+
+// Vectorised helpers used by the lexer to skip over runs of characters that don't produce tokens.
+// Each returns a pointer to the first character in [p, end) that stops the scan, or end if there is none.
+
+// Skips spaces, tabs and carriage returns
+const char *skipBlanks(const char *p, const char *end);
+
+// Finds the next newline
+const char *findLineEnd(const char *p, const char *end);
+
+// Finds the next character that ends a run of plain string contents: '"', '\\', '\r' or '\n'
+const char *findStringStop(const char *p, const char *end);
@@ -1,6 +1,7 @@
 #pragma once
 #include <iostream>
 #include <string>
+#include <string_view>
 
 enum class TokenType {
     INTEGER,
@@ -96,10 +97,18 @@ enum class TokenType {
     READFILE,
     WRITEFILE,
     CLOSEFILE,
+    SEEK,
+    GETRECORD,
+    PUTRECORD,
+    LOADCSV,
+    PERSISTENT,
+    PARALLEL,
+    REDUCE,
 
     READ,
     WRITE,
     APPEND,
+    RANDOM,
 
     LINE_END,
     EXPRESSION_END
@@ -108,9 +117,9 @@ enum class TokenType {
 struct Token {
     TokenType type;
     int line, column;
-    std::string value;
+    std::string_view value;
 
-    Token(const TokenType &type, int line, int column, const std::string &value = "");
+    Token(const TokenType &type, int line, int column, std::string_view value = {});
 };
 
 std::ostream &operator<<(std::ostream &os, const TokenType &t);
@@ -1,5 +1,6 @@
 #pragma once
 #include <memory>
+#include <span>
 #include "lexer/tokens.h"
 #include "interpreter/types/types.h"
 #include "interpreter/scope/context.h"
@@ -15,7 +15,7 @@ private:
 public:
     FunctionNode(
 			const Token &token,
-			const std::string &functionName,
+			std::string_view functionName,
 			std::vector<std::string> &&parameterNames,
 			std::vector<const Token*> &&parameterTypes,
 			std::vector<bool> &&parameterPassTypes,
@@ -30,10 +30,10 @@ public:
 class FunctionCallNode : public Node {
 private:
     const std::string functionName;
-    const std::vector<Node*> args;
+    const std::span<Node *const> args;
 
 public:
-    FunctionCallNode(const Token &token, std::vector<Node*> &&args);
+    FunctionCallNode(const Token &token, std::span<Node *const> args);
 
     std::unique_ptr<NodeResult> evaluate(Interpreter::Context &ctx) override;
 };
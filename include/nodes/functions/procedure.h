@@ -15,7 +15,7 @@ private:
 public:
     ProcedureNode(
 			const Token &token,
-			const std::string &procedureName,
+			std::string_view procedureName,
 			std::vector<std::string> &&parameterNames,
 			std::vector<const Token*> &&parameterTypes,
 			std::vector<bool> &&parameterPassTypes,
@@ -29,10 +29,10 @@ public:
 class CallNode : public Node {
 private:
     const std::string procedureName;
-    const std::vector<Node*> args;
+    const std::span<Node *const> args;
 
 public:
-    CallNode(const Token &token, const std::string &procedureName, std::vector<Node*> &&args);
+    CallNode(const Token &token, std::string_view procedureName, std::span<Node *const> args);
 
     std::unique_ptr<NodeResult> evaluate(Interpreter::Context &ctx) override;
 };
@@ -1,6 +1,7 @@
 #pragma once
 #include "nodes/base.h"
 #include "interpreter/file.h"
+#include "nodes/variable/resolver.h"
 
 class OpenFileNode : public Node {
 private:
@@ -17,9 +18,10 @@ class ReadFileNode : public Node {
 private:
     Node &filename;
     const Token &identifier;
+    const size_t fileSite;
 
 public:
-    ReadFileNode(const Token &token, Node &filename, const Token &identifier);
+    ReadFileNode(const Token &token, Node &filename, const Token &identifier, size_t fileSite);
 
     std::unique_ptr<NodeResult> evaluate(Interpreter::Context &ctx) override;
 };
@@ -27,9 +29,10 @@ public:
 class WriteFileNode : public UnaryNode {
 private:
     Node &filename;
+    const size_t fileSite;
 
 public:
-    WriteFileNode(const Token &token, Node &filename, Node &node);
+    WriteFileNode(const Token &token, Node &filename, Node &node, size_t fileSite);
 
     std::unique_ptr<NodeResult> evaluate(Interpreter::Context &ctx) override;
 };
@@ -37,9 +40,46 @@ public:
 class CloseFileNode : public Node {
 private:
     Node &filename;
+    const size_t fileSite;
 
 public:
-    CloseFileNode(const Token &token, Node &filename);
+    CloseFileNode(const Token &token, Node &filename, size_t fileSite);
+
+    std::unique_ptr<NodeResult> evaluate(Interpreter::Context &ctx) override;
+};
+
+class SeekNode : public UnaryNode {
+private:
+    Node &filename;
+    const size_t fileSite;
+
+public:
+    SeekNode(const Token &token, Node &filename, Node &node, size_t fileSite);
+
+    std::unique_ptr<NodeResult> evaluate(Interpreter::Context &ctx) override;
+};
+
+// GETRECORD and PUTRECORD, which only differ in the direction the record is copied
+class RecordNode : public Node {
+private:
+    Node &filename;
+    const AbstractVariableResolver &resolver;
+    const size_t fileSite;
+
+public:
+    RecordNode(const Token &token, Node &filename, const AbstractVariableResolver &resolver, size_t fileSite);
+
+    std::unique_ptr<NodeResult> evaluate(Interpreter::Context &ctx) override;
+};
+
+class LoadCsvNode : public Node {
+private:
+    Node &filename;
+    const AbstractVariableResolver &array;
+    const AbstractVariableResolver *const rowCount;
+
+public:
+    LoadCsvNode(const Token &token, Node &filename, const AbstractVariableResolver &array, const AbstractVariableResolver *rowCount);
 
     std::unique_ptr<NodeResult> evaluate(Interpreter::Context &ctx) override;
 };
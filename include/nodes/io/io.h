@@ -4,20 +4,20 @@
 
 class OutputNode : public Node {
 private:
-    const std::vector<Node*> nodes;
+    const std::span<Node *const> nodes;
 
 public:
-    OutputNode(const Token &token, std::vector<Node*> &&nodes);
+    OutputNode(const Token &token, std::span<Node *const> nodes);
 
     std::unique_ptr<NodeResult> evaluate(Interpreter::Context &ctx) override;
 };
 
 class InputNode : public Node {
 private:
-    const std::unique_ptr<AbstractVariableResolver> resolver;
+    const AbstractVariableResolver &resolver;
 
 public:
-    InputNode(const Token &token, std::unique_ptr<AbstractVariableResolver> &&resolver);
+    InputNode(const Token &token, const AbstractVariableResolver &resolver);
 
     std::unique_ptr<NodeResult> evaluate(Interpreter::Context &ctx) override;
 };
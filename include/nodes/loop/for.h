@@ -1,15 +1,50 @@
 #pragma once
+#include <span>
 #include "nodes/base.h"
 #include "interpreter/scope/block.h"
 
+class FunctionCallNode;
+
 class ForLoopNode : public Node {
-private:
+protected:
     const Token &identifier;
     Node &start, &stop, *step;
     Interpreter::Block *block;
+    // Set for loops inside a PARALLEL FOR, which keep their iterator in the iteration's frame
+    const bool localIterator;
+
+    void evaluateRange(Interpreter::Context &ctx, Interpreter::int_t &startValue, Interpreter::int_t &stopValue, Interpreter::int_t &stepValue);
+
+public:
+    ForLoopNode(const Token &token, const Token &identifier, Node &start, Node &stop, Node *step, Interpreter::Block *block, bool localIterator = false);
+
+    std::unique_ptr<NodeResult> evaluate(Interpreter::Context &ctx) override;
+};
+
+// Spreads iterations over the shared thread pool, each one running in its own frame with its own iterator.
+// The parser only accepts bodies that don't write anything shared between iterations.
+class ParallelForNode : public ForLoopNode {
+public:
+    // A variable named in the loop's REDUCE clause, which every chunk of iterations accumulates separately
+    struct Reduction {
+        enum class Operation {
+            SUM, COUNT, MIN, MAX
+        };
+
+        Operation operation;
+        const Token *variable;
+    };
+
+private:
+    // User defined functions aren't safe to run on several threads, loops calling them run on one
+    std::span<FunctionCallNode *const> calls;
+    std::span<const Reduction> reductions;
+
+    void runIteration(Interpreter::Context &ctx, Interpreter::int_t value, std::span<Interpreter::Variable *const> accumulators);
 
 public:
-    ForLoopNode(const Token &token, const Token &identifier, Node &start, Node &stop, Node *step, Interpreter::Block *block);
+    ParallelForNode(const Token &token, const Token &identifier, Node &start, Node &stop, Node *step, Interpreter::Block *block,
+        std::span<FunctionCallNode *const> calls, std::span<const Reduction> reductions);
 
     std::unique_ptr<NodeResult> evaluate(Interpreter::Context &ctx) override;
 };
@@ -8,10 +8,14 @@ class ArrayDeclareNode : public Node {
 private:
     const std::vector<const Token*> identifiers;
     const Token &type;
-    std::vector<Node*> bounds;
+    std::span<Node *const> bounds;
+    // File name of a PERSISTENT array
+    Node *const persistent;
+
+    void persist(Interpreter::Array &array, Interpreter::Context &ctx);
 
 public:
-    ArrayDeclareNode(const Token &token, std::vector<const Token*> &&identifiers, const Token &type, std::vector<Node*> &&bounds);
+    ArrayDeclareNode(const Token &token, std::vector<const Token*> &&identifiers, const Token &type, std::span<Node *const> bounds, Node *persistent = nullptr);
 
     std::unique_ptr<NodeResult> evaluate(Interpreter::Context &ctx) override;
 };
@@ -15,13 +15,13 @@ public:
 
 class PointerAssignNode : public Node {
 private:
-    std::unique_ptr<AbstractVariableResolver> pointerResolver, valueResolver;
+    const AbstractVariableResolver &pointerResolver, &valueResolver;
 
 public:
     PointerAssignNode(
         const Token &token,
-        std::unique_ptr<AbstractVariableResolver> &&pointerResolver,
-        std::unique_ptr<AbstractVariableResolver> &&valueResolver
+        const AbstractVariableResolver &pointerResolver,
+        const AbstractVariableResolver &valueResolver
     );
 
     std::unique_ptr<NodeResult> evaluate(Interpreter::Context &ctx) override;
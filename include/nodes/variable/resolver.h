@@ -1,5 +1,5 @@
 #pragma once
-#include <memory>
+#include <span>
 
 #include "lexer/tokens.h"
 #include "interpreter/variable.h"
@@ -19,34 +19,44 @@ public:
 
 class PointerDereferencer : public AbstractVariableResolver {
 private:
-    std::unique_ptr<AbstractVariableResolver> resolver;
+    const AbstractVariableResolver &resolver;
 
 public:
-    PointerDereferencer(const Token &token, std::unique_ptr<AbstractVariableResolver> &&resolver);
+    PointerDereferencer(const Token &token, const AbstractVariableResolver &resolver);
 
     Interpreter::DataHolder &resolve(Interpreter::Context &ctx) const override;
+
+    const AbstractVariableResolver &getResolver() const;
 };
 
 class CompositeResolver : public AbstractVariableResolver {
 private:
-    std::unique_ptr<AbstractVariableResolver> resolver;
+    const AbstractVariableResolver &resolver;
     const Token &member;
 
 public:
-    CompositeResolver(const Token &token, std::unique_ptr<AbstractVariableResolver> &&resolver, const Token &member);
+    CompositeResolver(const Token &token, const AbstractVariableResolver &resolver, const Token &member);
 
     Interpreter::DataHolder &resolve(Interpreter::Context &ctx) const override;
+
+    const AbstractVariableResolver &getResolver() const;
+
+    const Token &getMember() const;
 };
 
 class ArrayElementResolver : public AbstractVariableResolver {
 private:
-    std::vector<Node*> indices;
-    std::unique_ptr<AbstractVariableResolver> resolver;
+    std::span<Node *const> indices;
+    const AbstractVariableResolver &resolver;
 
 public:
-    ArrayElementResolver(const Token &token, std::unique_ptr<AbstractVariableResolver> &&resolver, std::vector<Node*> &&indicies);
+    ArrayElementResolver(const Token &token, const AbstractVariableResolver &resolver, std::span<Node *const> indices);
 
     Interpreter::DataHolder &resolve(Interpreter::Context &ctx) const override;
+
+    const AbstractVariableResolver &getResolver() const;
+
+    std::span<Node *const> getIndices() const;
 };
 
 class SimpleVariableSource : public AbstractVariableResolver {
@@ -55,7 +65,7 @@ public:
 
     Interpreter::DataHolder &resolve(Interpreter::Context &ctx) const override;
 
-    const std::string &getName() const;
+    std::string_view getName() const;
 
     const Token &getToken() const;
 };
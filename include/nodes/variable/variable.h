@@ -28,25 +28,25 @@ public:
 
 class AssignNode : public UnaryNode {
 private:
-    const std::unique_ptr<AbstractVariableResolver> resolver;
+    const AbstractVariableResolver &resolver;
 
     void assignArray(Interpreter::Context &ctx, const Interpreter::ArrayDirectAccessError &e);
 
 public:
     // token: ASSIGNMENT
-    AssignNode(const Token &token, Node &node, std::unique_ptr<AbstractVariableResolver> &&resolver);
+    AssignNode(const Token &token, Node &node, const AbstractVariableResolver &resolver);
 
     std::unique_ptr<NodeResult> evaluate(Interpreter::Context &ctx) override;
 };
 
 class AccessNode : public Node {
 private:
-    const std::unique_ptr<AbstractVariableResolver> resolver;
+    const AbstractVariableResolver &resolver;
     friend AssignNode;
 
 public:
     // token: IDENTIFIER
-    AccessNode(const Token &token, std::unique_ptr<AbstractVariableResolver> &&resolver);
+    AccessNode(const Token &token, const AbstractVariableResolver &resolver);
 
     std::unique_ptr<NodeResult> evaluate(Interpreter::Context &ctx) override;
 
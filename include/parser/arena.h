@@ -0,0 +1,80 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Bump pointer allocator owning the nodes, blocks and resolvers created by a Parser.
+// Objects are laid out in the order they are created and all destroyed together with the arena.
+class Arena {
+private:
+    struct Chunk {
+        std::unique_ptr<std::byte[]> data;
+        size_t size;
+    };
+
+    struct Destructor {
+        void (*destroy)(void*);
+        void *object;
+    };
+
+    std::vector<Chunk> chunks;
+    std::vector<Destructor> destructors;
+    std::byte *current = nullptr;
+    std::byte *end = nullptr;
+    size_t nextChunkSize = 16 * 1024;
+
+    void addChunk(size_t minSize);
+
+    inline void *allocate(size_t size, size_t align) {
+        size_t padding = (align - reinterpret_cast<uintptr_t>(current) % align) % align;
+        if (current == nullptr || static_cast<size_t>(end - current) < size + padding) {
+            addChunk(size + align);
+            padding = (align - reinterpret_cast<uintptr_t>(current) % align) % align;
+        }
+
+        void *ptr = current + padding;
+        current += padding + size;
+        return ptr;
+    }
+
+public:
+    Arena() = default;
+
+    Arena(const Arena&) = delete;
+
+    Arena &operator=(const Arena&) = delete;
+
+    ~Arena();
+
+    // Makes sure the next `bytes` worth of allocations fit in a single chunk
+    void reserve(size_t bytes);
+
+    template<typename T, typename... Args>
+    T *make(Args&&... args) {
+        T *object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            destructors.push_back({[](void *p) { static_cast<T*>(p)->~T(); }, object});
+        }
+        return object;
+    }
+
+    // Copies the contents of a temporary container into the arena
+    template<std::ranges::contiguous_range R>
+    auto copy(const R &values) {
+        using T = std::ranges::range_value_t<R>;
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        size_t count = std::ranges::size(values);
+        if (count == 0) return std::span<const T>();
+
+        T *data = static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+        std::uninitialized_copy_n(std::ranges::data(values), count, data);
+        return std::span<const T>(data, count);
+    }
+};
@@ -0,0 +1,26 @@
+#pragma once
+#include <mutex>
+#include <span>
+#include "lexer/tokens.h"
+#include "interpreter/scope/block.h"
+
+class Parser;
+
+// Body of a procedure or function, only parsed the first time it is run
+class LazyBlock : public Interpreter::Block {
+private:
+    Parser &parser;
+    // Tokens of the body, ending with its ENDPROCEDURE or ENDFUNCTION
+    const std::span<const Token> tokens;
+    Interpreter::Block *block = nullptr;
+    // Programs run with several inputs at once can reach the body on several threads
+    std::once_flag parsed;
+
+public:
+    LazyBlock(Parser &parser, std::span<const Token> tokens);
+
+    // Parses the body unless that has already been done, throwing any syntax error in it
+    void parse();
+
+    void run(Interpreter::Context &ctx) override;
+};
@@ -1,8 +1,12 @@
 #pragma once
 #include <vector>
+#include <span>
 #include <concepts>
 #include <memory>
+#include <mutex>
 #include "lexer/tokens.h"
+#include "parser/arena.h"
+#include "parser/lazyBlock.h"
 #include "nodes/node.h"
 #include "nodes/variable/resolver.h"
 #include "interpreter/error.h"
@@ -10,12 +14,54 @@
 
 class Parser {
 private:
-    const std::vector<Token*> *tokens;
-    std::vector<std::unique_ptr<Node>> nodes;
-    std::vector<std::unique_ptr<Interpreter::Block>> blocks;
+    friend LazyBlock;
+
+    std::span<const Token> tokens;
+    Arena arena;
+
+    // Whether a COLON follows each token before the end of its line, marking where CASE labels start
+    std::vector<bool> colonAhead;
+
+    const Token *currentToken = nullptr;
+    size_t idx = 0;
+
+    // Site ids given to statements working on files, numbered per parser so FileManager::getFile's table stays as small as the program
+    size_t fileSites = 0;
+
+    // Held while parsing a body when it is first run, which may happen on several threads at once
+    std::mutex deferredMutex;
+    // Every body skipped so far, for parseDeferred()
+    std::vector<LazyBlock*> deferred;
+
+    // A variable, or part of one, read or assigned to in a PARALLEL FOR body that isn't local to an iteration
+    struct ParallelAccess {
+        const Token *token;
+        std::string_view variable;
+        // The variable and the members and elements leading to the first element indexed by the iterator, with the position
+        // of that index, such as `Grid[0]` for `Grid[i, j]`. Empty if there is no such element, so the access may reach other iterations' parts
+        std::string slice;
+        // Whether it goes through a pointer, which could point anywhere
+        bool dereferenced = false;
+        bool local = false;
+    };
 
-    const Token *currentToken;
-    size_t idx;
+    // Set while parsing the body of a PARALLEL FOR loop, to check that its iterations are independent
+    struct ParallelBody {
+        const Token &iterator;
+        // Variables declared in the blocks being parsed, and iterators of the loops being parsed, which belong to a single iteration
+        std::vector<std::string_view> locals;
+        std::vector<FunctionCallNode*> calls;
+        // Depth of loops inside the body, only their iterations can be left with BREAK
+        int loops = 0;
+        std::span<const ParallelForNode::Reduction> reductions;
+        // Uses of reduced variables not yet known to be the update their operation allows, any left at the end are errors
+        std::vector<const Token*> reducedUses;
+        // Set while parsing the block of `IF x < v THEN` (`>` for MAX), where v can be assigned x
+        const ParallelForNode::Reduction *guarded = nullptr;
+        std::span<const Token> guardedValue;
+        std::vector<ParallelAccess> reads, writes;
+    };
+    ParallelBody *parallelBody = nullptr;
 
     void advance();
 
@@ -25,27 +71,39 @@ private:
 
     template<std::derived_from<Node> T, typename... Args>
     inline T *create(Args&&... args) {
-        T *node = new T(std::forward<Args>(args)...);
-        nodes.emplace_back(node);
-        return node;
+        return arena.make<T>(std::forward<Args>(args)...);
     }
 
     enum class BlockType {
         MAIN, CASE, OTHER
     };
 
+    // Binary operator precedence levels, from loosest to tightest binding
+    enum class Precedence {
+        NONE, LOGICAL, COMPARISON, CONCATENATION, ADDITIVE, MULTIPLICATIVE
+    };
+
 public:
     Parser() = default;
 
-    Parser(const std::vector<Token*> *tokens);
+    Parser(std::span<const Token> tokens);
 
     Interpreter::Block *parse();
 
-    void setTokens(const std::vector<Token*> *_tokens);
+    // Parses the routine bodies that haven't been run yet, so syntax errors in routines that are never called still get reported
+    void parseDeferred();
+
+    void setTokens(std::span<const Token> _tokens);
 
 private:
     Interpreter::Block *parseBlock(BlockType blockType = BlockType::OTHER);
 
+    // Skips over a routine body up to and including endType, returning a block that parses it when first run
+    LazyBlock *skipRoutineBody(TokenType endType, const std::string &expected);
+
+    // Parses a body skipped by skipRoutineBody, leaving the current position untouched
+    Interpreter::Block *parseDeferredBlock(std::span<const Token> body);
+
     Node *parseFunction();
 
     Node *parseCall();
@@ -66,12 +124,44 @@ private:
 
     Node *parseCloseFile();
 
+    Node *parseSeek();
+
+    // GETRECORD and PUTRECORD
+    Node *parseRecord();
+
+    Node *parseLoadCsv();
+
     Node *parseType();
 
     Node *parseComposite(const Token &token, const Token &identifier);
 
+    // FOR and PARALLEL FOR
     Node *parseForLoop();
 
+    // Throws for statements that can't be part of a PARALLEL FOR body
+    void checkParallelStatement();
+
+    // Throws unless an assignment in a PARALLEL FOR body only changes what belongs to one iteration
+    void checkParallelAssignment(const Token &token, const AbstractVariableResolver &target);
+
+    ParallelAccess parallelAccess(const Token &token, const AbstractVariableResolver &resolver) const;
+
+    // Records a read in a PARALLEL FOR body, checked against the body's assignments once it has been parsed
+    void addParallelRead(const Token &token, const AbstractVariableResolver &resolver);
+
+    // Throws if a PARALLEL FOR body reads anything another iteration may assign to
+    void checkParallelReads();
+
+    // The reduction of the PARALLEL FOR loop being parsed that accumulates into name, if any
+    const ParallelForNode::Reduction *findReduction(std::string_view name) const;
+
+    // Throws unless assigning value to a reduced variable is `v <- v + x` for SUM and COUNT, or inside the block guarded by
+    // `IF x < v` for MIN and `IF x > v` for MAX, uses being how many uses of reduced variables there were before the assignment
+    void checkReducedAssignment(const Token &token, const ParallelForNode::Reduction &reduction, Node &value, std::span<const Token> valueTokens, size_t uses);
+
+    // Parses the block of an IF in a PARALLEL FOR body, letting it assign to a MIN or MAX reduced variable if condition guards it
+    Interpreter::Block *parseGuardedBlock(Node &condition, std::span<const Token> conditionTokens, size_t uses);
+
     Node *parseRepeatLoop();
 
     Node *parseWhileLoop();
@@ -88,17 +178,17 @@ private:
 
     Node *parseEvaluationExpression();
 
-    Node *parseLogicalExpression();
-
-    Node *parseComparisonExpression();
-
     Node *parseStringExpression();
 
     Node *parseArithmeticExpression();
 
-    Node *parseTerm();
+    static Precedence getPrecedence(TokenType type);
+
+    Node *parseBinaryExpression(Precedence minPrecedence);
+
+    Node *createBinaryNode(Precedence precedence, const Token &op, Node &left, Node &right);
 
-    Node *parseFactor();
+    Node *parseUnary();
 
     Node *parseAtom();
 
@@ -110,7 +200,7 @@ private:
 
     Node *parseModDivFn();
 
-    std::unique_ptr<AbstractVariableResolver> parseIdentifierExpression();
+    AbstractVariableResolver *parseIdentifierExpression();
 
     template<std::derived_from<Node> T>
     inline Node *parseLiteral() {
@@ -1,6 +1,7 @@
 #include "pch.h"
 
 #include "interpreter/array.h"
+#include "interpreter/record.h"
 
 using namespace Interpreter;
 
@@ -31,6 +32,19 @@ Array::Array(const Array &other)
     dimensions(Array::copyDimensions(other.dimensions))
 {}
 
+Array::~Array() {
+    if (file == nullptr) return;
+
+    // Every element has the same record size as the first one
+    size_t recordSize = data.empty() ? 0 : Record::size(*data[0]);
+    char *record = file->data();
+    for (auto &element : data) {
+        Record::store(*element, record);
+        record += recordSize;
+    }
+    file->save();
+}
+
 void Array::copyData(const Array &other) {
     for (size_t i = 0; i < data.size(); i++) {
         data[i] = std::make_unique<Interpreter::Variable>(*(other.data[i]), other.data[i]->parent);
@@ -74,3 +88,24 @@ Variable &Array::getElement(const std::vector<int_t> &index) {
 
     return *(data[realIndex]);
 }
+
+Variable &Array::getElementAt(size_t position) {
+    return *(data[position]);
+}
+
+size_t Array::getSize() const {
+    return data.size();
+}
+
+bool Array::persist(std::unique_ptr<ArrayFile> &&arrayFile, bool load, Context &ctx) {
+    if (load) {
+        size_t recordSize = Record::size(*data[0]);
+        const char *record = arrayFile->data();
+        for (auto &element : data) {
+            if (!Record::load(*element, record, ctx)) return false;
+            record += recordSize;
+        }
+    }
+    file = std::move(arrayFile);
+    return true;
+}
@@ -0,0 +1,45 @@
+#include "pch.h"
+#include <system_error>
+
+#include "interpreter/arrayFile.h"
+
+using namespace Interpreter;
+
+ArrayFile::Status ArrayFile::open(const std::filesystem::path &filename, size_t size) {
+    path = filename;
+
+    std::error_code ec;
+    bool exists = std::filesystem::exists(filename, ec);
+    if (ec) return Status::FAILED;
+    uintmax_t fileSize = exists ? std::filesystem::file_size(filename, ec) : 0;
+    if (ec) return Status::FAILED;
+    if (fileSize != 0 && fileSize != size) return Status::WRONG_SIZE;
+
+    buffer.assign(size, '\0');
+    if (fileSize == 0) {
+        // Checks the file can be written before the program relies on it
+        if (!save()) return Status::FAILED;
+        return Status::CREATED;
+    }
+
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.read(buffer.data(), size)) return Status::FAILED;
+    return Status::OPENED;
+}
+
+char *ArrayFile::data() {
+    return buffer.data();
+}
+
+bool ArrayFile::save() {
+    std::filesystem::path temporary = path;
+    temporary += ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file.write(buffer.data(), buffer.size()) || !file.flush()) return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temporary, path, ec);
+    return !ec;
+}
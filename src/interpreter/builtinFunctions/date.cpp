@@ -96,7 +96,7 @@ void Interpreter::BuiltinFnSETDATE::run(Interpreter::Context &ctx) {
 
     year_month_day ymd(year, month, day);
     if (!ymd.ok())
-        throw Interpreter::RuntimeError(Interpreter::errToken, ctx, "Invalid Date!");
+        throw Interpreter::RuntimeError(Interpreter::callToken(ctx), ctx, "Invalid Date!");
 
     auto ret = std::make_unique<Interpreter::Date>(ymd);
 
@@ -1,6 +1,7 @@
 #include "pch.h"
 #include <math.h>
 
+#include "interpreter/error.h"
 #include "interpreter/variable.h"
 #include "interpreter/scope/context.h"
 #include "interpreter/builtinFunctions/functions.h"
@@ -16,8 +17,10 @@ void Interpreter::BuiltinFnRand::run(Interpreter::Context &ctx) {
     Interpreter::Variable *x = ctx.getVariable("x");
     if (x == nullptr || x->type != Interpreter::DataType::INTEGER) std::abort();
 
-    auto ret = std::make_unique<Interpreter::Real>(rand() % x->get<Interpreter::Integer>().value);
-    ret->value += rand() / (real_t) RAND_MAX;
+    if (x->get<Interpreter::Integer>().value <= 0)
+        throw Interpreter::RuntimeError(Interpreter::callToken(ctx), ctx, "Argument for 'RAND' function must be positive");
+
+    auto ret = std::make_unique<Interpreter::Real>(ctx.getInstance().getRandom(x->get<Interpreter::Integer>().value));
 
     ctx.returnValue = std::make_unique<NodeResult>(std::move(ret), Interpreter::DataType::REAL);
 }
@@ -44,9 +44,9 @@ void Interpreter::BuiltinFnRight::run(Interpreter::Context &ctx) {
 
     int_t xVal = x->get<Interpreter::Integer>().value;
     if (xVal < 0)
-        throw Interpreter::RuntimeError(Interpreter::errToken, ctx, "Length for 'RIGHT' function cannot be negative");
+        throw Interpreter::RuntimeError(Interpreter::callToken(ctx), ctx, "Length for 'RIGHT' function cannot be negative");
     if (static_cast<size_t>(xVal) > strLen)
-        throw Interpreter::RuntimeError(Interpreter::errToken, ctx, "Length for 'RIGHT' function cannot exceed string length");
+        throw Interpreter::RuntimeError(Interpreter::callToken(ctx), ctx, "Length for 'RIGHT' function cannot exceed string length");
 
     auto ret = std::make_unique<Interpreter::String>();
 
@@ -85,15 +85,15 @@ void Interpreter::BuiltinFnMid::run(Interpreter::Context &ctx) {
 
     int_t xVal = x->get<Interpreter::Integer>().value - 1;
     if (xVal < 0)
-        throw Interpreter::RuntimeError(Interpreter::errToken, ctx, "Index for 'MID' function cannot be negative");
+        throw Interpreter::RuntimeError(Interpreter::callToken(ctx), ctx, "Index for 'MID' function cannot be negative");
     if (static_cast<size_t>(xVal) >= strLen)
-        throw Interpreter::RuntimeError(Interpreter::errToken, ctx, "Index for 'MID' function cannot exceed string length");
+        throw Interpreter::RuntimeError(Interpreter::callToken(ctx), ctx, "Index for 'MID' function cannot exceed string length");
 
     int_t yVal = y->get<Interpreter::Integer>().value;
     if (yVal < 0)
-        throw Interpreter::RuntimeError(Interpreter::errToken, ctx, "Length for 'MID' function cannot be negative");
+        throw Interpreter::RuntimeError(Interpreter::callToken(ctx), ctx, "Length for 'MID' function cannot be negative");
     if (static_cast<size_t>(yVal + xVal) > strLen)
-        throw Interpreter::RuntimeError(Interpreter::errToken, ctx, "Substring length in 'MID' function cannot exceed string length");
+        throw Interpreter::RuntimeError(Interpreter::callToken(ctx), ctx, "Substring length in 'MID' function cannot exceed string length");
 
     ret->value = strVal.substr(xVal, yVal);
 
@@ -120,9 +120,9 @@ void Interpreter::BuiltinFnLeft::run(Interpreter::Context &ctx) {
 
     int_t xVal = x->get<Interpreter::Integer>().value;
     if (xVal < 0)
-        throw Interpreter::RuntimeError(Interpreter::errToken, ctx, "Length for 'LEFT' function cannot be negative");
+        throw Interpreter::RuntimeError(Interpreter::callToken(ctx), ctx, "Length for 'LEFT' function cannot be negative");
     if (static_cast<size_t>(xVal) > strVal.size())
-        throw Interpreter::RuntimeError(Interpreter::errToken, ctx, "Length for 'LEFT' function cannot exceed string length");
+        throw Interpreter::RuntimeError(Interpreter::callToken(ctx), ctx, "Length for 'LEFT' function cannot exceed string length");
 
     auto ret = std::make_unique<Interpreter::String>();
     ret->value = strVal.substr(0, xVal);
@@ -246,9 +246,9 @@ void Interpreter::BuiltinFnEOF::run(Interpreter::Context &ctx) {
     Interpreter::File *file = ctx.getFileManager().getFile(filenameStr);
     
     if (file == nullptr)
-        throw Interpreter::FileNotOpenError(Interpreter::errToken, ctx, filenameStr.value);
-    if (file->getMode() != FileMode::READ)
-        throw Interpreter::RuntimeError(Interpreter::errToken, ctx, "File is not open in READ mode");
+        throw Interpreter::FileNotOpenError(Interpreter::callToken(ctx), ctx, filenameStr.value);
+    if (file->getMode() != FileMode::READ && file->getMode() != FileMode::RANDOM)
+        throw Interpreter::RuntimeError(Interpreter::callToken(ctx), ctx, "File is not open in READ or RANDOM mode");
     
     Interpreter::Boolean *eof = new Interpreter::Boolean;
     *eof = file->eof();
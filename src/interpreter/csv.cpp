@@ -0,0 +1,155 @@
+#include "pch.h"
+#include <charconv>
+
+#include "interpreter/csv.h"
+#include "interpreter/scope/context.h"
+
+using namespace Interpreter;
+
+CsvReader::CsvReader(std::string_view text) : text(text) {}
+
+std::string_view CsvReader::readQuoted(size_t fieldIdx) {
+    // position is just past the opening quote
+    size_t start = position;
+    size_t end = text.find('"', position);
+    bool escaped = false;
+    while (end != std::string_view::npos && end + 1 < text.size() && text[end + 1] == '"') {
+        escaped = true;
+        end = text.find('"', end + 2);
+    }
+    if (end == std::string_view::npos) end = text.size();
+
+    std::string_view field = text.substr(start, end - start);
+    for (char c : field) if (c == '\n') line++;
+    position = std::min(end + 1, text.size());
+
+    // Anything between the closing quote and the next separator is kept, as spreadsheets do
+    size_t rest = text.find_first_of(",\n", position);
+    if (rest == std::string_view::npos) rest = text.size();
+    bool trailing = rest > position && !(rest == position + 1 && text[position] == '\r' && text[rest] == '\n');
+    size_t after = position;
+    position = rest;
+    if (!escaped && !trailing) return field;
+
+    while (unescaped.size() <= fieldIdx) unescaped.emplace_back();
+    std::string &value = unescaped[fieldIdx];
+    value.clear();
+    for (size_t i = 0; i < field.size(); i++) {
+        value += field[i];
+        if (field[i] == '"') i++;
+    }
+    if (trailing) value.append(text.substr(after, rest - after));
+    return value;
+}
+
+bool CsvReader::next() {
+    fields.clear();
+
+    // Skip blank lines
+    while (position < text.size() && (text[position] == '\n' || text[position] == '\r')) {
+        if (text[position] == '\n') line++;
+        position++;
+    }
+    if (position >= text.size()) return false;
+
+    rowLine = line;
+    while (true) {
+        std::string_view field;
+        bool quoted = position < text.size() && text[position] == '"';
+        if (quoted) {
+            position++;
+            field = readQuoted(fields.size());
+        } else {
+            size_t end = text.find_first_of(",\n", position);
+            if (end == std::string_view::npos) end = text.size();
+            field = text.substr(position, end - position);
+            position = end;
+        }
+
+        if (position >= text.size() || text[position] == '\n') {
+            if (!quoted && !field.empty() && field.back() == '\r') field.remove_suffix(1);
+            fields.push_back(field);
+            if (position < text.size()) {
+                position++;
+                line++;
+            }
+            return true;
+        }
+
+        // At a separator
+        fields.push_back(field);
+        position++;
+    }
+}
+
+std::span<const std::string_view> CsvReader::row() const {
+    return fields;
+}
+
+int CsvReader::getLine() const {
+    return rowLine;
+}
+
+template<typename T>
+static bool parseNumber(std::string_view field, T &value) {
+    if (!field.empty() && field.front() == '+') field.remove_prefix(1);
+    if (field.empty()) return false;
+    auto [end, ec] = std::from_chars(field.data(), field.data() + field.size(), value);
+    return ec == std::errc() && end == field.data() + field.size();
+}
+
+bool CsvReader::setValue(Variable &var, std::string_view field, Context &ctx) {
+    if (var.type != DataType::STRING) {
+        size_t start = field.find_first_not_of(' ');
+        if (start == std::string_view::npos) start = field.size();
+        field.remove_prefix(start);
+        while (!field.empty() && field.back() == ' ') field.remove_suffix(1);
+    }
+
+    switch (var.type.type) {
+        case DataType::INTEGER:
+            return parseNumber(field, var.get<Integer>().value);
+        case DataType::REAL:
+            return parseNumber(field, var.get<Real>().value);
+        case DataType::BOOLEAN:
+            if (field != "TRUE" && field != "FALSE") return false;
+            var.get<Boolean>().value = field == "TRUE";
+            return true;
+        case DataType::CHAR:
+            if (field.size() != 1) return false;
+            var.get<Char>().value = field[0];
+            return true;
+        case DataType::STRING:
+            var.get<String>().value = field;
+            return true;
+        case DataType::DATE: {
+            // Same day/month/year form dates are output in
+            unsigned day, month;
+            int year;
+            size_t first = field.find('/'), second = field.find('/', first + 1);
+            if (first == std::string_view::npos || second == std::string_view::npos) return false;
+            if (!parseNumber(field.substr(0, first), day)
+                || !parseNumber(field.substr(first + 1, second - first - 1), month)
+                || !parseNumber(field.substr(second + 1), year)) return false;
+
+            std::chrono::year_month_day date{std::chrono::year(year), std::chrono::month(month), std::chrono::day(day)};
+            if (!date.ok()) return false;
+            var.get<Date>().date = date;
+            return true;
+        } case DataType::ENUM: {
+            Enum &value = var.get<Enum>();
+            const std::vector<std::string> &names = value.getDefinition(ctx).values;
+            for (size_t i = 0; i < names.size(); i++) {
+                if (names[i] == field) {
+                    value.idx = i;
+                    return true;
+                }
+            }
+            return false;
+        } case DataType::NONE:
+        case DataType::POINTER:
+        case DataType::COMPOSITE:
+            return false;
+    }
+    return false;
+}
@@ -15,19 +15,17 @@ Error::Error(const Token &token, const std::string &info)
     : Error(token, "Error", info)
 {}
 
-// FIXME: Very bad :(
-const std::string_view psfilename = "hello";
-std::string Error::toStr() const {
+std::string Error::toStr(std::string_view filename) const {
     std::ostringstream os;
-    os << type << " on line " << token.line << ", column " << token.column << " of " << psfilename;
+    os << type << " on line " << token.line << ", column " << token.column << " of " << filename;
     if (!info.empty()) {
         os << ":\n" << info;
     }
     return os.str();
 }
 
-void Error::print(std::ostream &os) const {
-    os << toStr() << std::endl;
+void Error::print(std::ostream &os, std::string_view filename) const {
+    os << toStr(filename) << std::endl;
 }
 
 
@@ -63,25 +61,34 @@ RuntimeError::RuntimeError(const Token &token, const Context &context, const std
     : Error(token, "Runtime Error", info), context(context)
 {
     std::ostringstream os;
-    os << type << " in file " << psfilename;
     if (info.size() > 0) {
         os << ":\n" << info;
     }
 
     os << "\n\nTraceback:\n" << context.getName() << ", line " << token.line << ", column " << token.column;
 
+    // Deep recursion only shows the outermost and innermost calls
+    constexpr size_t shownCalls = 20;
+    size_t depth = context.getDepth();
     const Context *ctx = context.getParent();
     while (ctx != nullptr) {
+        size_t ctxDepth = ctx->getDepth();
+        if (ctxDepth + shownCalls < depth && ctxDepth >= shownCalls) {
+            os << "\n... " << depth - 2 * shownCalls << " more calls ...";
+            while (ctx->getDepth() >= shownCalls) ctx = ctx->getParent();
+            continue;
+        }
         os << "\n" << ctx->getName() << ", line " << ctx->switchToken->line << ", column " << ctx->switchToken->column;
-        Context *parent = ctx->getParent();
-        ctx = parent;
+        ctx = ctx->getParent();
     }
 
     rtInfo = os.str();
 }
 
-std::string RuntimeError::toStr() const {
-    return rtInfo;
+std::string RuntimeError::toStr(std::string_view filename) const {
+    std::string str = type + " in file ";
+    str += filename;
+    return str + rtInfo;
 }
 
 
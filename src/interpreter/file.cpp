@@ -1,23 +1,114 @@
 #include "pch.h"
 
 #include "interpreter/file.h"
+#include "interpreter/readAhead.h"
+#include <cerrno>
+#include <cstdlib>
 #include <filesystem>
+#include <fcntl.h>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 using namespace Interpreter;
 
+namespace {
+    struct FileSettings {
+        size_t bufferSize = 1 << 20;
+        // Seconds between syncs to disk, 0 to sync whenever the buffer is written out, negative to never sync
+        double fsyncInterval = -1;
+        // Buffers of readAheadSize bytes filled ahead of READFILE by a background thread, 0 to read them on demand
+        size_t readAheadBuffers = 0;
+        static constexpr size_t readAheadSize = 1 << 20;
+
+        FileSettings() {
+            if (const char *env = std::getenv("PSEUDOENGINE2_WRITE_BUFFER")) {
+                long size = std::atol(env);
+                if (size > 0) bufferSize = size;
+            }
+            if (const char *env = std::getenv("PSEUDOENGINE2_FSYNC")) {
+                char *end;
+                double interval = std::strtod(env, &end);
+                if (end != env && interval >= 0) fsyncInterval = interval;
+            }
+            if (const char *env = std::getenv("PSEUDOENGINE2_READ_AHEAD")) {
+                long buffers = std::atol(env);
+                if (buffers > 0) readAheadBuffers = buffers;
+            }
+        }
+    };
+
+    const FileSettings &fileSettings() {
+        static const FileSettings settings;
+        return settings;
+    }
+
+#ifdef _WIN32
+    int openFile(const char *path, int flags) { return _open(path, flags | O_BINARY, 0666); }
+    long writeFile(int fd, const char *data, size_t size) { return _write(fd, data, (unsigned int) size); }
+    void closeFile(int fd) { _close(fd); }
+    void syncFile(int fd) { _commit(fd); }
+    long readAt(int fd, char *data, size_t size, uint64_t offset) {
+        if (_lseeki64(fd, offset, SEEK_SET) < 0) return -1;
+        return _read(fd, data, (unsigned int) size);
+    }
+    long writeAt(int fd, const char *data, size_t size, uint64_t offset) {
+        if (_lseeki64(fd, offset, SEEK_SET) < 0) return -1;
+        return _write(fd, data, (unsigned int) size);
+    }
+    uint64_t fileSize(int fd) {
+        __int64 size = _lseeki64(fd, 0, SEEK_END);
+        return size < 0 ? 0 : size;
+    }
+    bool isRegularFile(int fd) {
+        struct _stat64 st;
+        return _fstat64(fd, &st) == 0 && (st.st_mode & _S_IFREG);
+    }
+#else
+    int openFile(const char *path, int flags) { return ::open(path, flags, 0666); }
+    long writeFile(int fd, const char *data, size_t size) { return ::write(fd, data, size); }
+    void closeFile(int fd) { ::close(fd); }
+    void syncFile(int fd) { ::fsync(fd); }
+    long readAt(int fd, char *data, size_t size, uint64_t offset) { return ::pread(fd, data, size, offset); }
+    long writeAt(int fd, const char *data, size_t size, uint64_t offset) { return ::pwrite(fd, data, size, offset); }
+    uint64_t fileSize(int fd) {
+        struct stat st;
+        return ::fstat(fd, &st) == 0 ? st.st_size : 0;
+    }
+    bool isRegularFile(int fd) {
+        struct stat st;
+        return ::fstat(fd, &st) == 0 && S_ISREG(st.st_mode);
+    }
+#endif
+}
+
 File::File(const String &name, FileMode mode) : mode(mode), name(name) {
     switch (mode) {
-        case FileMode::READ:
-            ifile = std::make_unique<std::ifstream>();
-            ifile->open(name.value);
+        case FileMode::READ: {
+            // Pipes and other special files are never read ahead, closing one early mustn't wait on its writer.
+            // Nothing is mapped either, so the file being truncated while open can't fault READFILE
+            const FileSettings &settings = fileSettings();
+            fd = openFile(name.value.c_str(), O_RDONLY);
+            if (fd >= 0 && settings.readAheadBuffers > 0 && isRegularFile(fd)) {
+                prefetch = std::make_unique<ReadAhead>(fd, settings.readAheadBuffers, FileSettings::readAheadSize);
+            } else {
+                reader = std::make_unique<InputReader>(fd);
+            }
             break;
+        }
         case FileMode::WRITE:
-            ofile = std::make_unique<std::ofstream>();
-            ofile->open(name.value);
+        case FileMode::APPEND: {
+            fd = openFile(name.value.c_str(), O_WRONLY | O_CREAT | (mode == FileMode::WRITE ? O_TRUNC : O_APPEND));
+            lastSync = std::chrono::steady_clock::now();
             break;
-        case FileMode::APPEND:
-            ofile = std::make_unique<std::ofstream>();
-            ofile->open(name.value, std::ios_base::app);
+        }
+        case FileMode::RANDOM:
+            fd = openFile(name.value.c_str(), O_RDWR | O_CREAT);
+            lastSync = std::chrono::steady_clock::now();
             break;
     }
 }
@@ -31,51 +122,237 @@ FileMode File::getMode() {
 }
 
 bool File::eof() {
+    if (mode == FileMode::RANDOM) {
+        // True once no whole record is left to read
+        if (recordSize == 0) return size() == 0;
+        return (record + 1) * recordSize > size();
+    }
     if (mode != FileMode::READ) std::abort();
-    return ifile->eof();
+    if (prefetch != nullptr) return !nextChunk();
+    return reader->atEnd();
+}
+
+uint64_t File::size() {
+    return fd < 0 ? 0 : fileSize(fd);
 }
 
 void File::close() {
     if (mode == FileMode::READ) {
-        ifile->close();
+        reader.reset();
+        prefetch.reset();
+        chunk = {};
+        if (fd >= 0) closeFile(fd);
+        fd = -1;
     } else {
-        ofile->close();
+        flush(true);
+        if (fd >= 0) closeFile(fd);
+        fd = -1;
     }
     open = false;
 }
 
-String File::read() {
-    String line;
-    std::getline(*ifile, line.value);
+bool File::nextChunk() {
+    while (chunk.empty()) {
+        if (chunkEnded) return false;
+        if (chunkHeld) prefetch->release();
+
+        chunk = prefetch->next();
+        chunkHeld = !chunk.empty();
+        chunkEnded = chunk.empty();
+    }
+    return true;
+}
+
+std::string_view File::read() {
+    if (prefetch != nullptr) {
+        if (!nextChunk()) return {};
+
+        size_t end = chunk.find('\n');
+        if (end != std::string_view::npos) {
+            std::string_view line = chunk.substr(0, end);
+            chunk.remove_prefix(end + 1);
+            return line;
+        }
+
+        // The line carries on into the next chunks, so it's put together in a separate buffer
+        carry.assign(chunk);
+        chunk = {};
+        while (nextChunk()) {
+            end = chunk.find('\n');
+            if (end != std::string_view::npos) {
+                carry.append(chunk.data(), end);
+                chunk.remove_prefix(end + 1);
+                break;
+            }
+            carry += chunk;
+            chunk = {};
+        }
+        return carry;
+    }
+
+    std::string_view line;
+    reader->readLine(line);
     return line;
 }
 
-void File::write(const String &data) {
-    *ofile << data.value << "\n";
+void File::write(std::string_view data) {
+    buffer += data;
+    buffer += '\n';
+
+    const FileSettings &settings = fileSettings();
+    if (buffer.size() >= settings.bufferSize) {
+        flush();
+    } else if (settings.fsyncInterval > 0
+            && std::chrono::duration<double>(std::chrono::steady_clock::now() - lastSync).count() >= settings.fsyncInterval) {
+        flush();
+    }
+}
+
+void File::flush(bool closing) {
+    const char *data = buffer.data();
+    size_t size = buffer.size();
+    while (fd >= 0 && size > 0) {
+        long written = writeFile(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            // Write errors were never reported by WRITEFILE, the lines are dropped as before
+            break;
+        }
+        data += written;
+        size -= written;
+    }
+    buffer.clear();
+
+    double interval = fileSettings().fsyncInterval;
+    if (fd < 0 || interval < 0) return;
+
+    auto now = std::chrono::steady_clock::now();
+    if (closing || std::chrono::duration<double>(now - lastSync).count() >= interval) {
+        syncFile(fd);
+        lastSync = now;
+    }
+}
+
+void File::seek(uint64_t index) {
+    record = index;
+}
+
+bool File::setRecordSize(size_t size) {
+    if (recordSize == 0) recordSize = size;
+    return recordSize == size;
 }
 
+bool File::getRecord(char *data) {
+    uint64_t offset = record * recordSize;
+    size_t done = 0;
+    while (done < recordSize) {
+        long count = readAt(fd, data + done, recordSize - done, offset + done);
+        if (count < 0 && errno == EINTR) continue;
+        if (count <= 0) return false;
+        done += count;
+    }
+    record++;
+    return true;
+}
+
+bool File::putRecord(const char *data) {
+    uint64_t offset = record * recordSize;
+    size_t done = 0;
+    while (done < recordSize) {
+        long count = writeAt(fd, data + done, recordSize - done, offset + done);
+        if (count < 0 && errno == EINTR) continue;
+        if (count <= 0) return false;
+        done += count;
+    }
+    record++;
+    return true;
+}
+
+
+size_t FileManager::findSlot(std::string_view name) const {
+    size_t mask = table.size() - 1;
+    size_t slot = std::hash<std::string_view>()(name) & mask;
+    while (table[slot] != empty && files[table[slot]]->name.value != name) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+void FileManager::grow() {
+    std::vector<size_t> old = std::move(table);
+    table.assign(old.empty() ? 16 : old.size() * 2, empty);
+    for (size_t handle : old) {
+        if (handle != empty) table[findSlot(files[handle]->name.value)] = handle;
+    }
+}
+
+File *FileManager::lookup(std::string_view name) {
+    if (table.empty()) return nullptr;
+    size_t handle = table[findSlot(name)];
+    return handle == empty ? nullptr : files[handle].get();
+}
 
 bool FileManager::createFile(const String &name, FileMode mode) {
     namespace fs = std::filesystem;
-    if (!fs::exists(fs::path(name.value)) && mode != FileMode::WRITE) return false;
-    files.emplace_back(std::make_unique<File>(name, mode));
+    if (!fs::exists(fs::path(name.value)) && mode != FileMode::WRITE && mode != FileMode::RANDOM) return false;
+
+    // Kept at most half full so probe sequences stay short
+    if ((openFiles + 1) * 2 > table.size()) grow();
+
+    size_t handle;
+    if (freeHandles.empty()) {
+        handle = files.size();
+        files.emplace_back();
+    } else {
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+    }
+    files[handle] = std::make_unique<File>(name, mode);
+    table[findSlot(name.value)] = handle;
+    openFiles++;
     return true;
 }
 
 File *FileManager::getFile(const String &name) {
-    for (auto &file : files) {
-        if (file->name.value == name.value) return file.get();
+    return lookup(name.value);
+}
+
+File *FileManager::getFile(const String &name, size_t site) {
+    if (site < siteHandles.size()) {
+        size_t handle = siteHandles[site];
+        if (handle < files.size() && files[handle] != nullptr && files[handle]->name.value == name.value)
+            return files[handle].get();
+    } else {
+        siteHandles.resize(site + 1, empty);
     }
-    return nullptr;
+
+    if (table.empty()) return nullptr;
+    size_t handle = table[findSlot(name.value)];
+    siteHandles[site] = handle;
+    return handle == empty ? nullptr : files[handle].get();
 }
 
 void FileManager::closeFile(const String &name) {
-    for (std::size_t i = 0; i < files.size(); i++) {
-        auto &file = files[i];
-        if (file->name.value == name.value) {
-            file->close();
-            files.erase(files.begin() + i);
-            return;
+    if (table.empty()) return;
+    size_t slot = findSlot(name.value);
+    size_t handle = table[slot];
+    if (handle == empty) return;
+
+    files[handle]->close();
+    files[handle].reset();
+    freeHandles.push_back(handle);
+    openFiles--;
+
+    // Shift later entries of the probe sequence back, so lookups never stop early at the hole
+    size_t mask = table.size() - 1;
+    size_t hole = slot;
+    for (size_t next = (slot + 1) & mask; table[next] != empty; next = (next + 1) & mask) {
+        size_t home = std::hash<std::string_view>()(files[table[next]]->name.value) & mask;
+        // Move the entry into the hole unless its home lies cyclically in (hole, next]
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            table[hole] = table[next];
+            hole = next;
         }
     }
+    table[hole] = empty;
 }
@@ -0,0 +1,74 @@
+#include "pch.h"
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
+#include <io.h>
+#define read _read
+#else
+#include <unistd.h>
+#endif
+
+#include "interpreter/input.h"
+
+static constexpr size_t chunkSize = 1 << 16;
+
+Interpreter::InputReader::InputReader(int fd, std::ostream *tied)
+    : fd(fd), tied(tied), buffer(chunkSize)
+{}
+
+Interpreter::InputReader &Interpreter::InputReader::shared() {
+    static InputReader reader(0, &std::cout);
+    return reader;
+}
+
+bool Interpreter::InputReader::fill() {
+    if (eof) return false;
+
+    // Move what is left to the front, and make room for a whole chunk after it
+    if (start > 0) {
+        std::memmove(buffer.data(), buffer.data() + start, end - start);
+        end -= start;
+        start = 0;
+    }
+    if (buffer.size() - end < chunkSize) buffer.resize(end + chunkSize);
+
+    if (tied != nullptr) tied->flush();
+
+    while (true) {
+        auto count = read(fd, buffer.data() + end, buffer.size() - end);
+        if (count < 0 && errno == EINTR) continue;
+        if (count <= 0) {
+            eof = true;
+            return false;
+        }
+        end += count;
+        return true;
+    }
+}
+
+bool Interpreter::InputReader::readLine(std::string_view &line) {
+    size_t searched = start;
+    while (true) {
+        const char *data = buffer.data();
+        const void *newline = std::memchr(data + searched, '\n', end - searched);
+        if (newline != nullptr) {
+            size_t lineEnd = static_cast<const char*>(newline) - data;
+            line = std::string_view(data + start, lineEnd - start);
+            start = lineEnd + 1;
+            return true;
+        }
+
+        searched = end - start;
+        if (!fill()) break;
+    }
+
+    // The last line may not end with a newline
+    line = std::string_view(buffer.data() + start, end - start);
+    start = end;
+    return !line.empty();
+}
+
+bool Interpreter::InputReader::atEnd() {
+    return start == end && !fill();
+}
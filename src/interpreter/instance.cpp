@@ -0,0 +1,53 @@
+#include "pch.h"
+
+#include "interpreter/error.h"
+#include "interpreter/instance.h"
+
+using namespace Interpreter;
+
+Instance::Instance(const std::string &filename, bool repl, std::ostream &output, std::ostream &errors, InputReader &input)
+    : filename(filename), repl(repl), output(output), errors(errors), input(input)
+{
+    std::random_device device;
+    std::seed_seq seed{device(), device()};
+    random.seed(seed);
+}
+
+const std::string &Instance::getFilename() const {
+    return filename;
+}
+
+bool Instance::isREPL() const {
+    return repl;
+}
+
+std::ostream &Instance::getOutput() {
+    return output;
+}
+
+std::ostream &Instance::getErrors() {
+    return errors;
+}
+
+InputReader &Instance::getInput() {
+    return input;
+}
+
+size_t Instance::getMaxCallDepth() const {
+    return maxCallDepth;
+}
+
+void Instance::setMaxCallDepth(size_t depth) {
+    maxCallDepth = depth;
+}
+
+real_t Instance::getRandom(real_t limit) {
+    std::uniform_real_distribution<real_t> distribution(0, limit);
+    std::lock_guard lock(randomMutex);
+    return distribution(random);
+}
+
+void Instance::report(const Error &error) {
+    output << "\n" << std::flush;
+    error.print(errors, filename);
+}
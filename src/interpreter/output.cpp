@@ -0,0 +1,63 @@
+#include "pch.h"
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
+#include <io.h>
+#define isatty _isatty
+#define write _write
+#else
+#include <unistd.h>
+#endif
+
+#include "interpreter/output.h"
+
+static constexpr size_t capacity = 1 << 16;
+
+Interpreter::OutputBuffer::OutputBuffer()
+    : lineBuffered(isatty(1))
+{
+    buffer.reserve(capacity);
+    previous = std::cout.rdbuf(this);
+}
+
+Interpreter::OutputBuffer::~OutputBuffer() {
+    flush();
+    std::cout.rdbuf(previous);
+}
+
+bool Interpreter::OutputBuffer::flush() {
+    const char *data = buffer.data();
+    size_t size = buffer.size();
+    while (size > 0) {
+        auto written = write(1, data, size);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            // Nothing more can be written, so drop the rest instead of retrying it forever
+            buffer.clear();
+            return false;
+        }
+        data += written;
+        size -= written;
+    }
+    buffer.clear();
+    return true;
+}
+
+Interpreter::OutputBuffer::int_type Interpreter::OutputBuffer::overflow(int_type c) {
+    if (traits_type::eq_int_type(c, traits_type::eof())) return traits_type::not_eof(c);
+
+    char ch = traits_type::to_char_type(c);
+    xsputn(&ch, 1);
+    return c;
+}
+
+std::streamsize Interpreter::OutputBuffer::xsputn(const char *s, std::streamsize n) {
+    buffer.append(s, n);
+    if (buffer.size() >= capacity || (lineBuffered && std::memchr(s, '\n', n) != nullptr)) flush();
+    return n;
+}
+
+int Interpreter::OutputBuffer::sync() {
+    return flush() ? 0 : -1;
+}
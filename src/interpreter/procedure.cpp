@@ -3,6 +3,7 @@
 #include "interpreter/scope/block.h"
 #include "interpreter/scope/context.h"
 #include "interpreter/procedure.h"
+#include "interpreter/builtinFunctions/functions.h"
 
 using namespace Interpreter;
 
@@ -52,3 +53,8 @@ Function::Function(const std::string &name, Interpreter::DataType returnType)
     returnType(returnType),
     defToken(nullptr)
 {}
+
+
+const Token &Interpreter::callToken(const Context &ctx) {
+    return *ctx.getParent()->switchToken;
+}
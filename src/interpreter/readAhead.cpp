@@ -0,0 +1,75 @@
+#include "pch.h"
+#include <cerrno>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "interpreter/readAhead.h"
+
+using namespace Interpreter;
+
+static long readFile(int fd, char *data, size_t size) {
+#ifdef _WIN32
+    return _read(fd, data, (unsigned int) size);
+#else
+    return ::read(fd, data, size);
+#endif
+}
+
+ReadAhead::ReadAhead(int fd, size_t chunks, size_t chunkSize)
+    : fd(fd), chunkSize(chunkSize), ring(std::max<size_t>(chunks, 2))
+{
+    for (Chunk &chunk : ring) chunk.data = std::make_unique<char[]>(chunkSize);
+    producer = std::thread(&ReadAhead::produce, this);
+}
+
+ReadAhead::~ReadAhead() {
+    stopping.store(true, std::memory_order_release);
+    // The producer only sleeps on `consumed`, so change it to wake it up
+    consumed.fetch_add(1, std::memory_order_release);
+    consumed.notify_one();
+    producer.join();
+}
+
+void ReadAhead::produce() {
+    for (size_t index = 0;; index++) {
+        size_t done = consumed.load(std::memory_order_acquire);
+        while (index - done >= ring.size() && !stopping.load(std::memory_order_acquire)) {
+            consumed.wait(done, std::memory_order_acquire);
+            done = consumed.load(std::memory_order_acquire);
+        }
+        if (stopping.load(std::memory_order_acquire)) return;
+
+        // Each chunk is whatever one read returns, an empty chunk marks the end (read errors included)
+        Chunk &chunk = ring[index % ring.size()];
+        long count;
+        do {
+            count = readFile(fd, chunk.data.get(), chunkSize);
+        } while (count < 0 && errno == EINTR);
+        chunk.size = count > 0 ? count : 0;
+
+        produced.store(index + 1, std::memory_order_release);
+        produced.notify_one();
+        if (chunk.size == 0) return;
+    }
+}
+
+std::string_view ReadAhead::next() {
+    size_t index = consumed.load(std::memory_order_relaxed);
+    size_t ready = produced.load(std::memory_order_acquire);
+    while (ready == index) {
+        produced.wait(ready, std::memory_order_acquire);
+        ready = produced.load(std::memory_order_acquire);
+    }
+
+    const Chunk &chunk = ring[index % ring.size()];
+    return std::string_view(chunk.data.get(), chunk.size);
+}
+
+void ReadAhead::release() {
+    consumed.fetch_add(1, std::memory_order_release);
+    consumed.notify_one();
+}
@@ -0,0 +1,155 @@
+#include "pch.h"
+#include <cstdint>
+#include <cstring>
+
+#include "interpreter/record.h"
+#include "interpreter/scope/context.h"
+
+using namespace Interpreter;
+
+namespace {
+    constexpr size_t stringSize = sizeof(uint16_t) + Record::maxStringLength;
+
+    template<typename T>
+    void put(char *&record, T value) {
+        std::memcpy(record, &value, sizeof(T));
+        record += sizeof(T);
+    }
+
+    template<typename T>
+    T take(const char *&record) {
+        T value;
+        std::memcpy(&value, record, sizeof(T));
+        record += sizeof(T);
+        return value;
+    }
+
+    bool store(Variable &var, char *&record) {
+        switch (var.type.type) {
+            case DataType::INTEGER:
+                put<int64_t>(record, var.get<Integer>().value);
+                return true;
+            case DataType::REAL:
+                put<double>(record, var.get<Real>().value);
+                return true;
+            case DataType::BOOLEAN:
+                put<uint8_t>(record, var.get<Boolean>().value);
+                return true;
+            case DataType::CHAR:
+                put<char>(record, var.get<Char>().value);
+                return true;
+            case DataType::STRING: {
+                const std::string &value = var.get<String>().value;
+                if (value.size() > Record::maxStringLength) return false;
+                put<uint16_t>(record, value.size());
+                std::memcpy(record, value.data(), value.size());
+                std::memset(record + value.size(), 0, Record::maxStringLength - value.size());
+                record += Record::maxStringLength;
+                return true;
+            } case DataType::DATE: {
+                const std::chrono::year_month_day &date = var.get<Date>().date;
+                put<int16_t>(record, int(date.year()));
+                put<uint8_t>(record, unsigned(date.month()));
+                put<uint8_t>(record, unsigned(date.day()));
+                return true;
+            } case DataType::ENUM:
+                put<uint32_t>(record, var.get<Enum>().idx);
+                return true;
+            case DataType::COMPOSITE:
+                for (const std::unique_ptr<Variable> &member : var.get<Composite>().ctx->getVariables()) {
+                    if (!store(*member, record)) return false;
+                }
+                return true;
+            case DataType::NONE:
+            case DataType::POINTER:
+                return false;
+        }
+        return false;
+    }
+
+    bool load(Variable &var, const char *&record, Context &ctx) {
+        switch (var.type.type) {
+            case DataType::INTEGER:
+                var.get<Integer>().value = take<int64_t>(record);
+                return true;
+            case DataType::REAL:
+                var.get<Real>().value = take<double>(record);
+                return true;
+            case DataType::BOOLEAN:
+                var.get<Boolean>().value = take<uint8_t>(record) != 0;
+                return true;
+            case DataType::CHAR:
+                var.get<Char>().value = take<char>(record);
+                return true;
+            case DataType::STRING: {
+                uint16_t length = take<uint16_t>(record);
+                if (length > Record::maxStringLength) return false;
+                var.get<String>().value.assign(record, length);
+                record += Record::maxStringLength;
+                return true;
+            } case DataType::DATE: {
+                int16_t year = take<int16_t>(record);
+                uint8_t month = take<uint8_t>(record);
+                uint8_t day = take<uint8_t>(record);
+                std::chrono::year_month_day date{std::chrono::year(year), std::chrono::month(month), std::chrono::day(day)};
+                if (!date.ok()) return false;
+                var.get<Date>().date = date;
+                return true;
+            } case DataType::ENUM: {
+                Enum &value = var.get<Enum>();
+                uint32_t idx = take<uint32_t>(record);
+                if (idx >= value.getDefinition(ctx).values.size()) return false;
+                value.idx = idx;
+                return true;
+            } case DataType::COMPOSITE: {
+                Context &members = *var.get<Composite>().ctx;
+                for (const std::unique_ptr<Variable> &member : members.getVariables()) {
+                    if (!load(*member, record, members)) return false;
+                }
+                return true;
+            } case DataType::NONE:
+            case DataType::POINTER:
+                return false;
+        }
+        return false;
+    }
+}
+
+size_t Record::size(Variable &var) {
+    switch (var.type.type) {
+        case DataType::INTEGER:
+        case DataType::REAL:
+            return 8;
+        case DataType::BOOLEAN:
+        case DataType::CHAR:
+            return 1;
+        case DataType::STRING:
+            return stringSize;
+        case DataType::DATE:
+        case DataType::ENUM:
+            return 4;
+        case DataType::COMPOSITE: {
+            const Context &members = *var.get<Composite>().ctx;
+            if (members.hasArrays()) return 0;
+
+            size_t total = 0;
+            for (const std::unique_ptr<Variable> &member : members.getVariables()) {
+                size_t memberSize = size(*member);
+                if (memberSize == 0) return 0;
+                total += memberSize;
+            }
+            return total;
+        } case DataType::NONE:
+        case DataType::POINTER:
+            return 0;
+    }
+    return 0;
+}
+
+bool Record::store(Variable &var, char *record) {
+    return ::store(var, record);
+}
+
+bool Record::load(Variable &var, const char *record, Context &ctx) {
+    return ::load(var, record, ctx);
+}
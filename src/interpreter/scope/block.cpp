@@ -8,42 +8,38 @@
 
 using namespace Interpreter;
 
-extern bool REPLMode;
-
-void Block::addNode(Node *node) {
-    nodes.push_back(node);
-}
+Block::Block(std::span<Node *const> nodes)
+    : nodes(nodes)
+{}
 
 void Block::runNodeREPL(Node *node, Interpreter::Context &ctx) {
     auto result = node->evaluate(ctx);
+    std::ostream &output = ctx.getInstance().getOutput();
 
     switch (result->type.type) {
         case Interpreter::DataType::INTEGER:
-            std::cout << result->get<Interpreter::Integer>();
+            output << result->get<Interpreter::Integer>();
             break;
         case Interpreter::DataType::REAL: {
-            Interpreter::real_t value = result->get<Interpreter::Real>().value;
-            std::cout << value;
-
-            double integerValue;
-            if (std::modf(value, &integerValue) == 0.0) std::cout << ".0";
+            char buffer[Interpreter::Real::formatSize];
+            output.write(buffer, Interpreter::Real::format(result->get<Interpreter::Real>().value, buffer, true));
             break;
         } case Interpreter::DataType::BOOLEAN:
-            std::cout << (result->get<Interpreter::Boolean>() ? "TRUE" : "FALSE");
+            output << (result->get<Interpreter::Boolean>() ? "TRUE" : "FALSE");
             break;
         case Interpreter::DataType::CHAR:
-            std::cout << "'" << result->get<Interpreter::Char>() << "'";
+            output << "'" << result->get<Interpreter::Char>() << "'";
             break;
         case Interpreter::DataType::STRING:
-            std::cout << "\"" << result->get<Interpreter::String>().value << "\"";
+            output << "\"" << result->get<Interpreter::String>().value << "\"";
             break;
         case Interpreter::DataType::DATE: {
             auto str = result->get<Interpreter::Date>().toString();
-            std::cout << str->value;
+            output << str->value;
             break;
         } case Interpreter::DataType::ENUM: {
             auto &resEnum = result->get<Interpreter::Enum>();
-            std::cout << resEnum.definitionName << ": " << resEnum.getString(ctx);
+            output << resEnum.definitionName << ": " << resEnum.getString(ctx);
             break;
         } case Interpreter::DataType::POINTER: {
             auto &resPtr = result->get<Interpreter::Pointer>();
@@ -56,22 +52,22 @@ void Block::runNodeREPL(Node *node, Interpreter::Context &ctx) {
                 if (tempCtx == nullptr) valid = false;
             }
 
-            std::cout << resPtr.definitionName << ": ";
+            output << resPtr.definitionName << ": ";
             if (valid) {
                 Interpreter::Variable *ptrValue = resPtr.getValue();
                 const std::string &valueStr = ptrValue == nullptr ? "null" : ptrValue->name;
-                std::cout << valueStr;
+                output << valueStr;
             } else {
-                std::cout << "{DELETED}";
+                output << "{DELETED}";
             }
             break;
         } case Interpreter::DataType::COMPOSITE:
-            std::cout << result->get<Interpreter::Composite>().definitionName << " object";
+            output << result->get<Interpreter::Composite>().definitionName << " object";
             break;
         case Interpreter::DataType::NONE:
             return;
     }
-    std::cout << std::endl;
+    output << '\n';
 }
 
 void Block::_run(Interpreter::Context &ctx) {
@@ -87,7 +83,7 @@ void Block::_runREPL(Interpreter::Context &ctx) {
 }
 
 void Block::run(Interpreter::Context &ctx) {
-    if (REPLMode) _runREPL(ctx);
+    if (ctx.getInstance().isREPL()) _runREPL(ctx);
     else _run(ctx);
 }
 
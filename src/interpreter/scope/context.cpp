@@ -10,11 +10,15 @@ Context::Context(Context *parent, const std::string &name)
 {}
 
 Context::Context(Context *parent, const std::string &name, bool isFunctionCtx, Interpreter::DataType returnType)
-    : parent(parent), name(name), isFunctionCtx(isFunctionCtx), isCompositeCtx(false), returnType(returnType)
+    : parent(parent), name(name), instance(parent != nullptr ? parent->instance : nullptr),
+    depth(parent != nullptr ? parent->depth + 1 : 0),
+    isFunctionCtx(isFunctionCtx), isCompositeCtx(false), returnType(returnType)
 {}
 
 Context::Context(Context *parent, const std::string &name, bool isCompositeCtx)
-    : parent(parent), name(name), isFunctionCtx(false), isCompositeCtx(isCompositeCtx), returnType(Interpreter::DataType::NONE)
+    : parent(parent), name(name), instance(parent != nullptr ? parent->instance : nullptr),
+    depth(parent != nullptr ? parent->depth + 1 : 0),
+    isFunctionCtx(false), isCompositeCtx(isCompositeCtx), returnType(Interpreter::DataType::NONE)
 {}
 
 template<typename T, typename... Args>
@@ -29,6 +33,8 @@ void copyPtrVector(const std::vector<std::unique_ptr<T>> &source, std::vector<st
 Context::Context(const Context &other)
     : parent(other.parent),
     name(other.name),
+    instance(other.instance),
+    depth(other.depth),
     isFunctionCtx(other.isFunctionCtx),
     isCompositeCtx(other.isCompositeCtx),
     returnType(other.returnType)
@@ -45,51 +51,68 @@ void Context::copyVariableData(const Context &other) {
     }
 }
 
-std::unique_ptr<Context> Context::createGlobalContext() {
-    auto ctx = std::make_unique<Context>(nullptr, "Program");
+const std::vector<std::unique_ptr<Variable>> &Context::getVariables() const {
+    return variables;
+}
 
-    ctx->functions.reserve(34);
-
-    ctx->addFunction(std::make_unique<Interpreter::BuiltinFnLength>());
-    ctx->addFunction(std::make_unique<Interpreter::BuiltinFnRight>());
-    ctx->addFunction(std::make_unique<Interpreter::BuiltinFnMid>());
-    ctx->addFunction(std::make_unique<Interpreter::BuiltinFnLeft>());
-    ctx->addFunction(std::make_unique<Interpreter::BuiltinFnToUpper>());
-    ctx->addFunction(std::make_unique<Interpreter::BuiltinFnToLower>());
-
-    ctx->addFunction(std::make_unique<Interpreter::BuiltinFnNumToStr>());
-    ctx->addFunction(std::make_unique<Interpreter::BuiltinFnStrToNum>());
-    ctx->addFunction(std::make_unique<Interpreter::BuiltinFnIsNum>());
-    ctx->addFunction(std::make_unique<Interpreter::BuiltinFnEOF>());
-
-    ctx->addFunction(std::make_unique<Interpreter::BuiltinFnLCase>());
-    ctx->addFunction(std::make_unique<Interpreter::BuiltinFnUCase>());
-    ctx->addFunction(std::make_unique<Interpreter::BuiltinFnASC>());
-    ctx->addFunction(std::make_unique<Interpreter::BuiltinFnCHR>());
-
-    ctx->addFunction(std::make_unique<Interpreter::BuiltinFnDAY>());
-    ctx->addFunction(std::make_unique<Interpreter::BuiltinFnMONTH>());
-    ctx->addFunction(std::make_unique<Interpreter::BuiltinFnYEAR>());
-    ctx->addFunction(std::make_unique<Interpreter::BuiltinFnDAYINDEX>());
-    ctx->addFunction(std::make_unique<Interpreter::BuiltinFnSETDATE>());
-    ctx->addFunction(std::make_unique<Interpreter::BuiltinFnTODAY>());
-
-    ctx->addFunction(std::make_unique<Interpreter::BuiltinFnRand>());
-    ctx->addFunction(std::make_unique<Interpreter::BuiltinFnInt>());
-
-    ctx->addFunction(std::make_unique<Interpreter::BuiltinFnPow>());
-    ctx->addFunction(std::make_unique<Interpreter::BuiltinFnExp>());
-    ctx->addFunction(std::make_unique<Interpreter::BuiltinFnSin>());
-    ctx->addFunction(std::make_unique<Interpreter::BuiltinFnCos>());
-    ctx->addFunction(std::make_unique<Interpreter::BuiltinFnTan>());
-    ctx->addFunction(std::make_unique<Interpreter::BuiltinFnASin>());
-    ctx->addFunction(std::make_unique<Interpreter::BuiltinFnACos>());
-    ctx->addFunction(std::make_unique<Interpreter::BuiltinFnATan>());
-    ctx->addFunction(std::make_unique<Interpreter::BuiltinFnATan2>());
-    ctx->addFunction(std::make_unique<Interpreter::BuiltinFnSqrt>());
-    ctx->addFunction(std::make_unique<Interpreter::BuiltinFnLog>());
-    ctx->addFunction(std::make_unique<Interpreter::BuiltinFnLn>());
+bool Context::hasArrays() const {
+    return !arrays.empty();
+}
+
+// Builtin functions never change, so every program shares one set of them
+static const std::vector<std::unique_ptr<Function>> &builtinFunctions() {
+    static const std::vector<std::unique_ptr<Function>> functions = []() {
+        std::vector<std::unique_ptr<Function>> functions;
+        functions.reserve(34);
+
+        functions.push_back(std::make_unique<Interpreter::BuiltinFnLength>());
+        functions.push_back(std::make_unique<Interpreter::BuiltinFnRight>());
+        functions.push_back(std::make_unique<Interpreter::BuiltinFnMid>());
+        functions.push_back(std::make_unique<Interpreter::BuiltinFnLeft>());
+        functions.push_back(std::make_unique<Interpreter::BuiltinFnToUpper>());
+        functions.push_back(std::make_unique<Interpreter::BuiltinFnToLower>());
+
+        functions.push_back(std::make_unique<Interpreter::BuiltinFnNumToStr>());
+        functions.push_back(std::make_unique<Interpreter::BuiltinFnStrToNum>());
+        functions.push_back(std::make_unique<Interpreter::BuiltinFnIsNum>());
+        functions.push_back(std::make_unique<Interpreter::BuiltinFnEOF>());
+
+        functions.push_back(std::make_unique<Interpreter::BuiltinFnLCase>());
+        functions.push_back(std::make_unique<Interpreter::BuiltinFnUCase>());
+        functions.push_back(std::make_unique<Interpreter::BuiltinFnASC>());
+        functions.push_back(std::make_unique<Interpreter::BuiltinFnCHR>());
+
+        functions.push_back(std::make_unique<Interpreter::BuiltinFnDAY>());
+        functions.push_back(std::make_unique<Interpreter::BuiltinFnMONTH>());
+        functions.push_back(std::make_unique<Interpreter::BuiltinFnYEAR>());
+        functions.push_back(std::make_unique<Interpreter::BuiltinFnDAYINDEX>());
+        functions.push_back(std::make_unique<Interpreter::BuiltinFnSETDATE>());
+        functions.push_back(std::make_unique<Interpreter::BuiltinFnTODAY>());
+
+        functions.push_back(std::make_unique<Interpreter::BuiltinFnRand>());
+        functions.push_back(std::make_unique<Interpreter::BuiltinFnInt>());
+
+        functions.push_back(std::make_unique<Interpreter::BuiltinFnPow>());
+        functions.push_back(std::make_unique<Interpreter::BuiltinFnExp>());
+        functions.push_back(std::make_unique<Interpreter::BuiltinFnSin>());
+        functions.push_back(std::make_unique<Interpreter::BuiltinFnCos>());
+        functions.push_back(std::make_unique<Interpreter::BuiltinFnTan>());
+        functions.push_back(std::make_unique<Interpreter::BuiltinFnASin>());
+        functions.push_back(std::make_unique<Interpreter::BuiltinFnACos>());
+        functions.push_back(std::make_unique<Interpreter::BuiltinFnATan>());
+        functions.push_back(std::make_unique<Interpreter::BuiltinFnATan2>());
+        functions.push_back(std::make_unique<Interpreter::BuiltinFnSqrt>());
+        functions.push_back(std::make_unique<Interpreter::BuiltinFnLog>());
+        functions.push_back(std::make_unique<Interpreter::BuiltinFnLn>());
+
+        return functions;
+    }();
+    return functions;
+}
 
+std::unique_ptr<Context> Context::createGlobalContext(Instance &instance) {
+    auto ctx = std::make_unique<Context>(nullptr, "Program");
+    ctx->instance = &instance;
     ctx->fileManager = std::make_unique<FileManager>();
 
     return ctx;
@@ -99,12 +122,26 @@ Context *Context::getParent() const {
     return parent;
 }
 
+size_t Context::getDepth() const {
+    return depth;
+}
+
 Context *Context::getGlobalContext() {
     Context *ctx = this;
     while (ctx->parent != nullptr) {ctx = ctx->parent;}
     return ctx;
 }
 
+Context *Context::getLookupContext() {
+    return isFrame ? parent : getGlobalContext();
+}
+
+std::unique_ptr<Context> Context::createFrame(Context &parent, const std::string &name) {
+    auto frame = std::make_unique<Context>(&parent, name);
+    frame->isFrame = true;
+    return frame;
+}
+
 const std::string &Context::getName() const {
     return name;
 }
@@ -113,20 +150,20 @@ void Context::addVariable(Variable *variable) {
     variables.emplace_back(variable);
 }
 
-Variable *Context::getVariable(const std::string &varName, bool global) {
+Variable *Context::getVariable(std::string_view varName, bool global) {
     for (auto &var : variables) {
         if (var->name == varName) return var.get();
     }
 
     if (!global || parent == nullptr) return nullptr;
-    return getGlobalContext()->getVariable(varName);
+    return getLookupContext()->getVariable(varName);
 }
 
 void Context::addProcedure(std::unique_ptr<Procedure> &&procedure) {
     procedures.emplace_back(std::move(procedure));
 }
 
-Procedure *Context::getProcedure(const std::string &procedureName) {
+Procedure *Context::getProcedure(std::string_view procedureName) {
     if (parent != nullptr) return parent->getProcedure(procedureName);
 
     for (auto &procedure : procedures) {
@@ -142,7 +179,7 @@ void Context::addFunction(std::unique_ptr<Function> &&function) {
     functions.emplace_back(std::move(function));
 }
 
-Function *Context::getFunction(const std::string &functionName) {
+Function *Context::getFunction(std::string_view functionName) {
     if (parent != nullptr) return parent->getFunction(functionName);
 
     for (auto &function : functions) {
@@ -151,6 +188,12 @@ Function *Context::getFunction(const std::string &functionName) {
         }
     }
 
+    for (auto &function : builtinFunctions()) {
+        if (functionName == function->name) {
+            return function.get();
+        }
+    }
+
     return nullptr;
 }
 
@@ -158,7 +201,7 @@ void Context::addArray(std::unique_ptr<Array> &&array) {
     arrays.emplace_back(std::move(array));
 }
 
-Array *Context::getArray(const std::string &arrayName, bool global) {
+Array *Context::getArray(std::string_view arrayName, bool global) {
     for (auto &array : arrays) {
         if (arrayName == array->name) {
             return array.get();
@@ -166,7 +209,7 @@ Array *Context::getArray(const std::string &arrayName, bool global) {
     }
 
     if (!global || parent == nullptr) return nullptr;
-    return getGlobalContext()->getArray(arrayName);
+    return getLookupContext()->getArray(arrayName);
 }
 
 Interpreter::DataType Context::getType(const Token &token, bool global) {
@@ -208,7 +251,7 @@ bool Context::isIdentifierType(const Token &identifier, bool global) {
     return false;
 }
 
-Enum *Context::getEnumElement(const std::string &value, bool global) {
+Enum *Context::getEnumElement(std::string_view value, bool global) {
     for (auto &definition : enums) {
         for (size_t i = 0; i < definition->values.size(); i++) {
             if (definition->values[i] == value) {
@@ -218,7 +261,7 @@ Enum *Context::getEnumElement(const std::string &value, bool global) {
             }
         }
     }
-    if (global && parent != nullptr) return getGlobalContext()->getEnumElement(value);
+    if (global && parent != nullptr) return getLookupContext()->getEnumElement(value);
     return nullptr;
 }
 
@@ -234,30 +277,34 @@ void Context::createCompositeDefinition(CompositeTypeDefinition &&definition) {
     composites.emplace_back(std::make_unique<CompositeTypeDefinition>(std::move(definition)));
 }
 
-const EnumTypeDefinition *Context::getEnumDefinition(const std::string &name, bool global) {
+const EnumTypeDefinition *Context::getEnumDefinition(std::string_view name, bool global) {
     for (const auto &e : enums) {
         if (e->name == name) return e.get();
     }
-    if (global && parent != nullptr) return getGlobalContext()->getEnumDefinition(name);
+    if (global && parent != nullptr) return getLookupContext()->getEnumDefinition(name);
     return nullptr;
 }
 
-const PointerTypeDefinition *Context::getPointerDefinition(const std::string &name, bool global) {
+const PointerTypeDefinition *Context::getPointerDefinition(std::string_view name, bool global) {
     for (const auto &p : pointers) {
         if (p->name == name) return p.get();
     }
-    if (global && parent != nullptr) return getGlobalContext()->getPointerDefinition(name);
+    if (global && parent != nullptr) return getLookupContext()->getPointerDefinition(name);
     return nullptr;
 }
 
-const CompositeTypeDefinition *Context::getCompositeDefinition(const std::string &name, bool global) {
+const CompositeTypeDefinition *Context::getCompositeDefinition(std::string_view name, bool global) {
     for (const auto &c : composites) {
         if (c->name == name) return c.get();
     }
-    if (global && parent != nullptr) return getGlobalContext()->getCompositeDefinition(name);
+    if (global && parent != nullptr) return getLookupContext()->getCompositeDefinition(name);
     return nullptr;
 }
 
 FileManager &Context::getFileManager() {
     return *(getGlobalContext()->fileManager);
 }
+
+Instance &Context::getInstance() const {
+    return *instance;
+}
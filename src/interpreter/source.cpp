@@ -0,0 +1,80 @@
+#include "pch.h"
+#include <iterator>
+#include <system_error>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "interpreter/source.h"
+
+using namespace Interpreter;
+
+SourceFile::~SourceFile() {
+#ifndef _WIN32
+    if (mapping != nullptr) munmap(const_cast<char*>(mapping), mappingSize);
+#endif
+}
+
+bool SourceFile::map(const std::filesystem::path &filename) {
+#ifndef _WIN32
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    // Empty files can't be mapped, and non-regular files may not support it
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0) {
+        close(fd);
+        return false;
+    }
+
+    void *ptr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED) return false;
+
+    // Sources are lexed front to back exactly once
+    madvise(ptr, st.st_size, MADV_SEQUENTIAL);
+
+    mapping = static_cast<const char*>(ptr);
+    mappingSize = st.st_size;
+    contents = std::string_view(mapping, mappingSize);
+    return true;
+#else
+    (void) filename;
+    return false;
+#endif
+}
+
+bool SourceFile::read(std::istream &stream) {
+    buffer.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    if (stream.bad()) return false;
+
+    contents = buffer;
+    return true;
+}
+
+bool SourceFile::open(const std::filesystem::path &filename) {
+    if (filename == "-") return read(std::cin);
+    return load(filename);
+}
+
+bool SourceFile::load(const std::filesystem::path &filename) {
+    if (map(filename)) return true;
+    return copy(filename);
+}
+
+bool SourceFile::copy(const std::filesystem::path &filename) {
+    std::error_code ec;
+    if (std::filesystem::is_directory(filename, ec)) return false;
+
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) return false;
+    return read(file);
+}
+
+std::string_view SourceFile::view() const {
+    return contents;
+}
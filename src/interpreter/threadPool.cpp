@@ -0,0 +1,105 @@
+#include "pch.h"
+#include <cstdlib>
+
+#include "interpreter/threadPool.h"
+
+// Set on worker threads so tasks that start batches of their own run them inline instead of deadlocking
+static thread_local bool onWorker = false;
+
+Interpreter::ThreadPool::ThreadPool(size_t threads) {
+    // The calling thread always takes part, so one thread less is needed
+    for (size_t i = 1; i < threads; i++) {
+        workers.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+Interpreter::ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread &worker : workers) worker.join();
+}
+
+Interpreter::ThreadPool &Interpreter::ThreadPool::shared() {
+    static ThreadPool pool([]() -> size_t {
+        if (const char *env = std::getenv("PSEUDOENGINE2_THREADS")) {
+            long threads = std::atol(env);
+            if (threads > 0) return threads;
+        }
+        return std::max(std::thread::hardware_concurrency(), 1u);
+    }());
+    return pool;
+}
+
+size_t Interpreter::ThreadPool::concurrency() const {
+    return workers.size() + 1;
+}
+
+void Interpreter::ThreadPool::work() {
+    onWorker = true;
+    unsigned long seen = 0;
+    while (true) {
+        {
+            std::unique_lock lock(mutex);
+            wake.wait(lock, [&]() { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+
+        runTasks();
+
+        std::lock_guard lock(mutex);
+        if (--busyWorkers == 0) finished.notify_one();
+    }
+}
+
+void Interpreter::ThreadPool::runTasks() {
+    size_t i;
+    while ((i = next.fetch_add(1, std::memory_order_relaxed)) < count) {
+        try {
+            (*task)(i);
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    }
+}
+
+void Interpreter::ThreadPool::run(size_t count, const std::function<void(size_t)> &task) {
+    std::unique_lock batch(batchMutex, std::defer_lock);
+    if (count <= 1 || workers.empty() || onWorker || !batch.try_lock()) {
+        // Same contract as a pooled batch: every task runs, then the first failure is rethrown
+        std::exception_ptr error;
+        for (size_t i = 0; i < count; i++) {
+            try {
+                task(i);
+            } catch (...) {
+                if (!error) error = std::current_exception();
+            }
+        }
+        if (error) std::rethrow_exception(error);
+        return;
+    }
+
+    {
+        std::lock_guard lock(mutex);
+        this->task = &task;
+        this->count = count;
+        next = 0;
+        errors.assign(count, nullptr);
+        busyWorkers = workers.size();
+        generation++;
+    }
+    wake.notify_all();
+
+    runTasks();
+
+    std::unique_lock lock(mutex);
+    finished.wait(lock, [&]() { return busyWorkers == 0; });
+    this->task = nullptr;
+
+    for (std::exception_ptr &error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+}
@@ -1,4 +1,5 @@
 #include "pch.h"
+#include <charconv>
 
 #include "interpreter/types/types.h"
 
@@ -59,27 +60,41 @@ std::unique_ptr<String> String::operator&(const String &other) const {
 }
 
 std::unique_ptr<Integer> String::toInteger() const {
-    const char *cStr = value.c_str();
-    char *end;
+    return std::make_unique<Integer>(parseInteger(value));
+}
+
+std::unique_ptr<Real> String::toReal() const {
+    return std::make_unique<Real>(parseReal(value));
+}
 
-    int_t x = std::strtol(cStr, &end, 10);
-    if (end[0] != '\0' || cStr[0] == '\0') {
+int_t String::parseInteger(std::string_view str) {
+    int_t x;
+    auto [end, ec] = std::from_chars(str.data(), str.data() + str.size(), x);
+    if (ec == std::errc() && end == str.data() + str.size()) return x;
+
+    // Leading whitespace, '+' signs and out of range values are rare, strtol handles them as before
+    std::string copy(str);
+    char *copyEnd;
+    x = std::strtol(copy.c_str(), &copyEnd, 10);
+    if (copyEnd[0] != '\0' || copy.empty()) {
         x = 0;
     }
-
-    return std::make_unique<Integer>(x);
+    return x;
 }
 
-std::unique_ptr<Real> String::toReal() const {
-    const char *cStr = value.c_str();
-    char *end;
+real_t String::parseReal(std::string_view str) {
+    real_t x;
+    auto [end, ec] = std::from_chars(str.data(), str.data() + str.size(), x);
+    if (ec == std::errc() && end == str.data() + str.size()) return x;
 
-    real_t x = std::strtod(cStr, &end);
-    if (end[0] != '\0' || cStr[0] == '\0') {
+    // As above, with hexadecimal numbers also left to strtod
+    std::string copy(str);
+    char *copyEnd;
+    x = std::strtod(copy.c_str(), &copyEnd);
+    if (copyEnd[0] != '\0' || copy.empty()) {
         x = 0.0;
     }
-
-    return std::make_unique<Real>(x);
+    return x;
 }
 
 std::unique_ptr<Boolean> String::toBoolean() const {
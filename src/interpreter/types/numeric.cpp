@@ -1,6 +1,7 @@
 #include "pch.h"
 
 #include <math.h>
+#include <charconv>
 #include "interpreter/types/types.h"
 
 using namespace Interpreter;
@@ -393,8 +394,21 @@ std::unique_ptr<Char> Real::toChar() const {
 }
 
 std::unique_ptr<String> Real::toString() const {
-    std::string s = std::to_string(value);
-    s.erase(s.find_last_not_of('0') + 1);
-    if (s.back() == '.') s.erase(s.size() - 1);
-    return std::make_unique<String>(s);
+    char buffer[formatSize];
+    size_t size = format(value, buffer, false);
+    return std::make_unique<String>(std::string(buffer, size));
+}
+
+size_t Real::format(real_t value, char *buffer, bool pointZero) {
+    // Plain decimals for everyday magnitudes, scientific notation for the rest, both with the fewest digits needed
+    real_t magnitude = std::fabs(value);
+    bool fixed = magnitude == 0.0 || (magnitude >= 1e-5 && magnitude < 1e15);
+    std::chars_format fmt = fixed ? std::chars_format::fixed : std::chars_format::scientific;
+
+    char *end = std::to_chars(buffer, buffer + formatSize, value, fmt).ptr;
+    if (pointZero && fixed && std::find(buffer, end, '.') == end) {
+        *end++ = '.';
+        *end++ = '0';
+    }
+    return end - buffer;
 }
@@ -72,7 +72,7 @@ void Composite::operator=(const Composite &other) {
     ctx->copyVariableData(*other.ctx);
 }
 
-DataHolder *Composite::getMember(const std::string &name) {
+DataHolder *Composite::getMember(std::string_view name) {
     Interpreter::Variable *var = ctx->getVariable(name);
     if (var != nullptr) return var;
 
@@ -0,0 +1,236 @@
+#include "pch.h"
+#include <chrono>
+#include <fcntl.h>
+#include <iomanip>
+#include <mutex>
+#include <optional>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "launch/run.h"
+#include "launch/memory.h"
+#include "interpreter/csv.h"
+#include "interpreter/threadPool.h"
+
+namespace {
+    struct Job {
+        std::filesystem::path program, input, expected;
+        // Line of the manifest the job came from, since results are written in the order jobs finish
+        size_t line = 0;
+
+        bool success = false;
+        // Whether the output matched the expected output, if there is one
+        std::optional<bool> passed;
+        double milliseconds = 0;
+        size_t peakMemory = 0;
+        std::string output, errors;
+    };
+}
+
+// Deepest calls can nest in a job, well within a thread's stack even in unoptimised builds
+static constexpr size_t jobCallDepth = 2000;
+
+static int openInput(const std::filesystem::path &path) {
+#ifdef _WIN32
+    return _wopen(path.c_str(), _O_RDONLY | _O_BINARY);
+#else
+    return ::open(path.c_str(), O_RDONLY);
+#endif
+}
+
+static void closeInput(int fd) {
+#ifdef _WIN32
+    _close(fd);
+#else
+    ::close(fd);
+#endif
+}
+
+// Outputs are compared ignoring whitespace at their ends, which programs and expected files often differ by
+static std::string_view trimEnd(std::string_view str) {
+    size_t end = str.find_last_not_of(" \t\r\n");
+    return str.substr(0, end == std::string_view::npos ? 0 : end + 1);
+}
+
+static void runJob(Job &job) {
+    std::ostringstream output, errors;
+
+    // Jobs without an input file read nothing, as if their input were empty
+    int fd = -1;
+    if (!job.input.empty()) {
+        fd = openInput(job.input);
+        if (fd < 0) {
+            job.errors = "error: input file " + job.input.string() + " not found!\n";
+            return;
+        }
+    }
+
+    try {
+        Interpreter::InputReader input(fd, &output);
+        Interpreter::Instance instance(job.program.string(), false, output, errors, input);
+        instance.setMaxCallDepth(jobCallDepth);
+
+        auto start = std::chrono::steady_clock::now();
+        MemoryTracker memory;
+        job.success = runFile(job.program, instance);
+        job.peakMemory = memory.peak();
+        job.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    } catch (const std::exception &e) {
+        // Errors that aren't the program's fault, such as running out of memory, only fail their own job
+        errors << "error: " << e.what() << "\n";
+    }
+    if (fd >= 0) closeInput(fd);
+
+    job.output = output.str();
+    job.errors = errors.str();
+
+    if (!job.expected.empty()) {
+        Interpreter::SourceFile expected;
+        if (!expected.copy(job.expected)) {
+            job.errors += "error: expected output file " + job.expected.string() + " not found!\n";
+            job.passed = false;
+        } else {
+            job.passed = trimEnd(job.output) == trimEnd(expected.view());
+        }
+    }
+}
+
+static void writeField(std::ostream &os, std::string_view field) {
+    os << '"';
+    for (char c : field) {
+        if (c == '"') os << '"';
+        os << c;
+    }
+    os << '"';
+}
+
+static void writeRow(std::ostream &os, const Job &job) {
+    os << job.line << ',';
+    writeField(os, job.program.string());
+    os << ',' << (job.success ? 0 : 1) << ',';
+    if (job.passed.has_value()) os << (*job.passed ? "pass" : "fail");
+    os << ',' << std::fixed << std::setprecision(3) << job.milliseconds << ',';
+    if (MemoryTracker::supported()) os << (job.peakMemory + 1023) / 1024;
+    os << ',';
+    writeField(os, job.output);
+    os << ',';
+    writeField(os, job.errors);
+    os << '\n';
+}
+
+bool runBatch(const std::filesystem::path &manifest, const std::filesystem::path &results) {
+    Interpreter::SourceFile manifestFile;
+    if (!manifestFile.copy(manifest)) {
+        std::cerr << "error: manifest " << manifest << " not found!" << std::endl;
+        return false;
+    }
+
+    // Relative paths in the manifest are relative to the manifest itself
+    std::filesystem::path base = manifest.parent_path();
+    auto resolve = [&](std::string_view field) -> std::filesystem::path {
+        if (field.empty()) return {};
+        std::filesystem::path path(field);
+        return path.is_relative() ? base / path : path;
+    };
+
+    std::vector<Job> jobs;
+    Interpreter::CsvReader reader(manifestFile.view());
+    while (reader.next()) {
+        std::span<const std::string_view> row = reader.row();
+        if (row.size() > 3 || row[0].empty()) {
+            std::cerr << "error: line " << reader.getLine() << " of manifest " << manifest
+                << " should be: program[,input file[,expected output file]]" << std::endl;
+            return false;
+        }
+
+        Job &job = jobs.emplace_back();
+        job.line = reader.getLine();
+        job.program = resolve(row[0]);
+        if (row.size() > 1) job.input = resolve(row[1]);
+        if (row.size() > 2) job.expected = resolve(row[2]);
+    }
+
+    std::ofstream file(results, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "error: cannot write results to " << results << std::endl;
+        return false;
+    }
+    file << "line,program,status,result,time_ms,peak_memory_kb,output,errors" << std::endl;
+
+    // Each row is written and flushed as soon as its job finishes, so results so far survive a crash
+    std::mutex fileMutex;
+    size_t failed = 0;
+    Interpreter::ThreadPool::shared().run(jobs.size(), [&](size_t i) {
+        Job &job = jobs[i];
+        runJob(job);
+
+        std::lock_guard lock(fileMutex);
+        if (!job.success || job.passed == false) failed++;
+        writeRow(file, job);
+        file.flush();
+        // Outputs are only needed until they're written
+        job.output = std::string();
+        job.errors = std::string();
+    });
+
+    std::cout << jobs.size() << " jobs run, " << failed << " failed" << std::endl;
+    return failed == 0 && file.flush();
+}
+
+bool runInputs(const std::filesystem::path &filename, const std::filesystem::path &directory) {
+    Program program;
+    Interpreter::Instance loader(filename.string());
+    if (!program.load(filename, loader)) return false;
+
+    std::vector<std::filesystem::path> inputs;
+    std::error_code ec;
+    for (const auto &entry : std::filesystem::directory_iterator(directory, ec)) {
+        // Outputs from earlier runs aren't inputs
+        if (entry.is_regular_file() && entry.path().extension() != ".out") inputs.push_back(entry.path());
+    }
+    if (ec) {
+        std::cerr << "error: directory " << directory << " not found!" << std::endl;
+        return false;
+    }
+    std::sort(inputs.begin(), inputs.end());
+
+    std::vector<std::string> errors(inputs.size());
+    std::vector<char> succeeded(inputs.size(), false);
+    Interpreter::ThreadPool::shared().run(inputs.size(), [&](size_t i) {
+        std::filesystem::path outputPath = inputs[i];
+        outputPath += ".out";
+        std::ofstream output(outputPath, std::ios::binary | std::ios::trunc);
+        int fd = openInput(inputs[i]);
+        if (!output || fd < 0) {
+            errors[i] = "error: cannot run with input " + inputs[i].string() + "\n";
+            if (fd >= 0) closeInput(fd);
+            return;
+        }
+
+        std::ostringstream errorStream;
+        {
+            Interpreter::InputReader input(fd, &output);
+            Interpreter::Instance instance(filename.string(), false, output, errorStream, input);
+            instance.setMaxCallDepth(jobCallDepth);
+            succeeded[i] = program.run(instance);
+        }
+        closeInput(fd);
+        errors[i] = errorStream.str();
+    });
+
+    size_t failed = 0;
+    for (size_t i = 0; i < inputs.size(); i++) {
+        if (succeeded[i]) continue;
+        failed++;
+        std::cerr << inputs[i].string() << ":\n" << errors[i];
+    }
+    std::cout << inputs.size() << " inputs run, " << failed << " failed" << std::endl;
+
+    // Routines that none of the inputs called are only checked once, after all of them
+    bool checked = program.check(loader);
+    return failed == 0 && checked;
+}
@@ -0,0 +1,246 @@
+#include "pch.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <random>
+#include <system_error>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "launch/cache.h"
+
+#ifndef PSEUDOENGINE2_VERSION
+#define PSEUDOENGINE2_VERSION "unknown"
+#endif
+
+// Bump whenever the layout below changes
+static constexpr uint32_t formatVersion = 3;
+
+static constexpr char magic[4] = {'P', 'E', '2', 'T'};
+
+// Set in Record::offset for values stored in the file's literal pool instead of the source
+static constexpr uint64_t poolFlag = uint64_t(1) << 63;
+
+struct Header {
+    char magic[4];
+    uint32_t format;
+    uint64_t key;
+    uint64_t sourceSize;
+    int64_t modified;
+    uint64_t pathSize;
+    uint64_t tokenCount;
+    uint64_t poolSize;
+};
+
+// The file is the header, the records, the literal pool, then the path of the source the entry was made from
+
+struct Record {
+    uint32_t type;
+    int32_t line;
+    int32_t column;
+    uint32_t length;
+    uint64_t offset;
+};
+
+// Hashes 8 bytes at a time, it only picks the file name, entries are checked against the path they were made for
+static uint64_t hashBytes(uint64_t hash, const char *bytes, size_t size) {
+    constexpr uint64_t prime = 0x100000001b3;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, 8);
+        hash = (hash ^ word) * prime;
+        hash ^= hash >> 29;
+    }
+    for (; i < size; i++) {
+        hash = (hash ^ static_cast<unsigned char>(bytes[i])) * prime;
+    }
+    return hash;
+}
+
+static uint64_t makeKey(std::string_view sourcePath) {
+    uint64_t key = 0xcbf29ce484222325;
+    // Anything that changes how a source is lexed invalidates existing entries
+    std::string_view version = PSEUDOENGINE2_VERSION;
+    key = hashBytes(key, version.data(), version.size());
+    uint32_t layout[] = {formatVersion, static_cast<uint32_t>(TokenType::EXPRESSION_END)};
+    key = hashBytes(key, reinterpret_cast<const char*>(layout), sizeof(layout));
+    return hashBytes(key, sourcePath.data(), sourcePath.size());
+}
+
+TokenCache::TokenCache(const std::filesystem::path &filename, const std::filesystem::path &directory) {
+    if (directory.empty() || filename == "-") return;
+
+    std::error_code ec;
+    std::filesystem::path canonical = std::filesystem::canonical(filename, ec);
+    if (ec) return;
+    auto time = std::filesystem::last_write_time(canonical, ec);
+    if (ec) return;
+
+    sourcePath = canonical.string();
+    modified = time.time_since_epoch().count();
+    key = makeKey(sourcePath);
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.tokens", static_cast<unsigned long long>(key));
+    path = directory / name;
+}
+
+std::filesystem::path TokenCache::defaultDirectory() {
+    const char *dir = std::getenv("PSEUDOENGINE2_CACHE_DIR");
+    if (dir == nullptr) return {};
+    return dir;
+}
+
+TokenCache::~TokenCache() {
+    unmap();
+}
+
+bool TokenCache::map() {
+#ifndef _WIN32
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(Header))) {
+        close(fd);
+        return false;
+    }
+
+    void *ptr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED) return false;
+
+    data = static_cast<const char*>(ptr);
+    size = st.st_size;
+    return true;
+#else
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+
+    buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    data = buffer.data();
+    size = buffer.size();
+    return true;
+#endif
+}
+
+void TokenCache::unmap() {
+#ifndef _WIN32
+    if (data != nullptr) munmap(const_cast<char*>(data), size);
+#endif
+    data = nullptr;
+    size = 0;
+    buffer.clear();
+}
+
+std::span<const Token> TokenCache::load(std::string_view source) {
+    if (path.empty() || !map()) return {};
+
+    Header header;
+    std::memcpy(&header, data, sizeof(Header));
+
+    bool valid = std::memcmp(header.magic, magic, sizeof(magic)) == 0
+        && header.format == formatVersion
+        && header.key == key
+        && header.sourceSize == source.size()
+        && header.modified == modified
+        && header.tokenCount <= (size - sizeof(Header)) / sizeof(Record)
+        && header.poolSize <= size - sizeof(Header) - header.tokenCount * sizeof(Record)
+        && header.pathSize == size - sizeof(Header) - header.tokenCount * sizeof(Record) - header.poolSize;
+    // Two paths with the same hash must not share tokens
+    valid = valid && header.pathSize == sourcePath.size()
+        && std::memcmp(data + size - sourcePath.size(), sourcePath.data(), sourcePath.size()) == 0;
+    if (!valid) {
+        unmap();
+        return {};
+    }
+
+    const char *records = data + sizeof(Header);
+    const char *pool = records + header.tokenCount * sizeof(Record);
+
+    tokens.clear();
+    tokens.reserve(header.tokenCount);
+    for (uint64_t i = 0; i < header.tokenCount; i++) {
+        Record record;
+        std::memcpy(&record, records + i * sizeof(Record), sizeof(Record));
+
+        // Never trust the file enough to read outside the source or the pool
+        bool inPool = record.offset & poolFlag;
+        uint64_t offset = record.offset & ~poolFlag;
+        uint64_t limit = inPool ? header.poolSize : source.size();
+        if (offset > limit || record.length > limit - offset || record.type > static_cast<uint32_t>(TokenType::EXPRESSION_END)) {
+            tokens.clear();
+            unmap();
+            return {};
+        }
+
+        const char *base = inPool ? pool : source.data();
+        tokens.emplace_back(static_cast<TokenType>(record.type), record.line, record.column, std::string_view(base + offset, record.length));
+    }
+
+    return tokens;
+}
+
+void TokenCache::store(std::string_view source, std::span<const Token> lexedTokens) {
+    if (path.empty()) return;
+
+    std::string pool;
+    std::vector<Record> records;
+    records.reserve(lexedTokens.size());
+    for (const Token &token : lexedTokens) {
+        Record record{static_cast<uint32_t>(token.type), token.line, token.column, static_cast<uint32_t>(token.value.size()), 0};
+
+        // Values are either views into the source or, for literals with escape sequences, owned by the lexer
+        const char *value = token.value.data();
+        if (token.value.empty()) {
+            record.offset = 0;
+        } else if (value >= source.data() && value + token.value.size() <= source.data() + source.size()) {
+            record.offset = value - source.data();
+        } else {
+            record.offset = pool.size() | poolFlag;
+            pool += token.value;
+        }
+        records.push_back(record);
+    }
+
+    Header header;
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.format = formatVersion;
+    header.key = key;
+    header.sourceSize = source.size();
+    header.modified = modified;
+    header.pathSize = sourcePath.size();
+    header.tokenCount = records.size();
+    header.poolSize = pool.size();
+
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+    if (ec) return;
+
+    // Write to a temporary file first so concurrent runs never see a partial entry
+    std::filesystem::path tempPath = path;
+    tempPath += ".tmp" + std::to_string(std::random_device()());
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(Record));
+        file.write(pool.data(), pool.size());
+        file.write(sourcePath.data(), sourcePath.size());
+        if (!file.good()) {
+            file.close();
+            std::filesystem::remove(tempPath, ec);
+            return;
+        }
+    }
+
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) std::filesystem::remove(tempPath, ec);
+}
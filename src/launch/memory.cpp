@@ -0,0 +1,179 @@
+#include "pch.h"
+#include <cstdlib>
+#include <new>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#define allocationSize malloc_usable_size
+#elif defined(_WIN32)
+#include <malloc.h>
+#define allocationSize _msize
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#define allocationSize malloc_size
+#endif
+
+#include "launch/memory.h"
+
+static thread_local MemoryTracker *tracker = nullptr;
+
+void trackAllocation(long long change) {
+    tracker->current += change;
+    tracker->highest = std::max(tracker->highest, tracker->current);
+}
+
+MemoryTracker::MemoryTracker() : previous(tracker) {
+    tracker = this;
+}
+
+MemoryTracker::~MemoryTracker() {
+    tracker = previous;
+}
+
+size_t MemoryTracker::peak() const {
+    return highest;
+}
+
+bool MemoryTracker::supported() {
+#ifdef allocationSize
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Every allocation goes through malloc, or its aligned counterpart, so its size can be looked up. Outside a tracker
+// this costs one thread local check over the standard versions. All forms are replaced, so none bypass the count
+
+#if defined(_WIN32)
+#define alignedSize(ptr, alignment) _aligned_msize(ptr, alignment, 0)
+#elif defined(allocationSize)
+#define alignedSize(ptr, alignment) allocationSize(ptr)
+#endif
+
+static void *allocate(std::size_t size) noexcept {
+    void *ptr = std::malloc(size == 0 ? 1 : size);
+#ifdef allocationSize
+    if (ptr != nullptr && tracker != nullptr) trackAllocation(allocationSize(ptr));
+#endif
+    return ptr;
+}
+
+static void deallocate(void *ptr) noexcept {
+    if (ptr == nullptr) return;
+#ifdef allocationSize
+    if (tracker != nullptr) trackAllocation(-static_cast<long long>(allocationSize(ptr)));
+#endif
+    std::free(ptr);
+}
+
+static void *allocateAligned(std::size_t size, std::align_val_t align) noexcept {
+    size_t alignment = static_cast<size_t>(align);
+#ifdef _WIN32
+    void *ptr = _aligned_malloc(size == 0 ? 1 : size, alignment);
+#else
+    // aligned_alloc wants a multiple of the alignment
+    void *ptr = std::aligned_alloc(alignment, (std::max<size_t>(size, 1) + alignment - 1) / alignment * alignment);
+#endif
+#ifdef alignedSize
+    if (ptr != nullptr && tracker != nullptr) trackAllocation(alignedSize(ptr, alignment));
+#endif
+    return ptr;
+}
+
+static void deallocateAligned(void *ptr, std::align_val_t align) noexcept {
+    if (ptr == nullptr) return;
+#ifdef alignedSize
+    if (tracker != nullptr) trackAllocation(-static_cast<long long>(alignedSize(ptr, static_cast<size_t>(align))));
+#endif
+    (void) align;
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+void *operator new(std::size_t size) {
+    void *ptr = allocate(size);
+    if (ptr == nullptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void *operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void *operator new(std::size_t size, std::align_val_t align) {
+    void *ptr = allocateAligned(size, align);
+    if (ptr == nullptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void *operator new[](std::size_t size, std::align_val_t align) {
+    return operator new(size, align);
+}
+
+void *operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, align);
+}
+
+void *operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, align);
+}
+
+void operator delete(void *ptr) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t&) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t&) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t align) noexcept {
+    deallocateAligned(ptr, align);
+}
+
+void operator delete[](void *ptr, std::align_val_t align) noexcept {
+    deallocateAligned(ptr, align);
+}
+
+void operator delete(void *ptr, std::size_t, std::align_val_t align) noexcept {
+    deallocateAligned(ptr, align);
+}
+
+void operator delete[](void *ptr, std::size_t, std::align_val_t align) noexcept {
+    deallocateAligned(ptr, align);
+}
+
+void operator delete(void *ptr, std::align_val_t align, const std::nothrow_t&) noexcept {
+    deallocateAligned(ptr, align);
+}
+
+void operator delete[](void *ptr, std::align_val_t align, const std::nothrow_t&) noexcept {
+    deallocateAligned(ptr, align);
+}
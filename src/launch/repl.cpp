@@ -1,9 +1,9 @@
 #include "pch.h"
 
 #include <string>
+#include <deque>
 #include "launch/run.h"
-
-extern bool REPLMode;
+#include "interpreter/input.h"
 
 static const std::string_view multilineKeywords[] = {
     "IF",
@@ -21,12 +21,17 @@ bool startREPL() {
 
     Lexer lexer;
     Parser parser;
-    auto globalCtx = Interpreter::Context::createGlobalContext();
+    // Definitions from earlier inputs keep referring to their source text
+    std::deque<std::string> sources;
+    Interpreter::Instance instance("<stdin>", true);
+    auto globalCtx = Interpreter::Context::createGlobalContext(instance);
+    Interpreter::InputReader &reader = instance.getInput();
 
     while (true) {
         std::cout << "> " << std::flush;
-        std::string input;
-        std::getline(std::cin, input);
+        std::string_view inputLine;
+        if (!reader.readLine(inputLine)) break;
+        std::string input(inputLine);
 
         size_t size = input.size();
         if (input.empty()) continue;
@@ -36,43 +41,39 @@ bool startREPL() {
                 std::cerr << "expected filename: INCLUDE <filename>" << std::endl;
                 continue;
             }
-            std::filesystem::path psfilename = input.substr(8, size - 8);
-            REPLMode = false;
-            
-            std::cout << "running file" << psfilename << "\n";
-			std::string_view statusMessage = runFile(psfilename) ? "success\n" : "error\n";
+            std::filesystem::path filename = input.substr(8, size - 8);
+            // The file runs as a separate program
+            Interpreter::Instance fileInstance(filename.string());
+
+            std::cout << "running file" << filename << "\n";
+			std::string_view statusMessage = runFile(filename, fileInstance) ? "success\n" : "error\n";
             std::cout << "\nprogram exited " << statusMessage << "\n";
-            
-            psfilename = "<stdin>";
-            REPLMode = true;
             continue;
         }
 
         for (const std::string_view &keyword : multilineKeywords) {
             if (input.starts_with(keyword)) {
                 if (keyword == "TYPE" && input.find("=") != std::string::npos) break;
-                std::string line = " ";
+                std::string_view line = " ";
                 while (line.size() > 0) {
 					input += "\n";
                     std::cout << ". " << std::flush;
-                    std::getline(std::cin, line);
+                    reader.readLine(line);
 					input += line;
                 }
                 break;
             }
         }
 
-        lexer.setExpr(&input);
+        lexer.setExpr(sources.emplace_back(std::move(input)));
         try {
-            const std::vector<Token*> &tokens = lexer.makeTokens();
-            parser.setTokens(&tokens);
+            auto tokens = lexer.makeTokens();
+            parser.setTokens(tokens);
             Interpreter::Block *block = parser.parse();
 
-            std::cout.precision(10);
             block->run(*globalCtx);
         } catch (const Interpreter::Error &e) {
-            std::cout << "\n";
-            e.print();
+            instance.report(e);
         }
     }
     return true;
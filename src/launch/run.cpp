@@ -1,46 +1,56 @@
 #include "pch.h"
-#include <fstream>
 #include <filesystem>
 
 #include "launch/run.h"
 
-bool runFile(std::filesystem::path &filename) {
-    std::ifstream fd(filename.c_str());
-
-    if (!fd.is_open()) {
-        std::cerr << "error: fd '" << filename << "' not found!" << std::endl;
+bool Program::load(const std::filesystem::path &filename, Interpreter::Instance &instance) {
+    // Made first, so a file changed while it's being read can't be cached under its new modification time
+    cache.emplace(filename, TokenCache::defaultDirectory());
+    if (!source.open(filename)) {
+        instance.getErrors() << "error: fd '" << filename << "' not found!" << std::endl;
         return false;
     }
+    std::string_view contents = source.view();
+
+    lexer.setExpr(contents);
+    try {
+        std::span<const Token> tokens = cache->load(contents);
+        if (tokens.empty()) {
+            tokens = lexer.makeTokens();
+            cache->store(contents, tokens);
+        }
 
-    std::string contents;
-	try {
-		contents.reserve(std::filesystem::file_size(filename));	
-	} catch (std::filesystem::filesystem_error &error) {
-		std::cerr << "error reading file: " << error.what() << error.code();
-		return false;
-	}
-	
-    while (fd.good()) {
-        std::string line;
-        std::getline(fd, line);
-		contents += line;
-		contents += "\n";
+        parser.setTokens(tokens);
+        block = parser.parse();
+    } catch (const Interpreter::Error &e) {
+        instance.report(e);
+        return false;
     }
-    fd.close();
+    return true;
+}
 
-    Lexer lexer(&contents);
+bool Program::run(Interpreter::Instance &instance) {
     try {
-        const std::vector<Token*> &tokens = lexer.makeTokens();
-        Parser parser(&tokens);
-        Interpreter::Block *block = parser.parse();
-        std::cout.precision(10);
-
-        auto globalCtx = Interpreter::Context::createGlobalContext();
+        auto globalCtx = Interpreter::Context::createGlobalContext(instance);
         block->run(*globalCtx);
     } catch (const Interpreter::Error &e) {
-        std::cout << "\n";
-        e.print();
+        instance.report(e);
         return false;
     }
     return true;
 }
+
+bool Program::check(Interpreter::Instance &instance) {
+    try {
+        parser.parseDeferred();
+    } catch (const Interpreter::Error &e) {
+        instance.report(e);
+        return false;
+    }
+    return true;
+}
+
+bool runFile(const std::filesystem::path &filename, Interpreter::Instance &instance) {
+    Program program;
+    return program.load(filename, instance) && program.run(instance) && program.check(instance);
+}
@@ -1,84 +1,167 @@
 #include "pch.h"
-#include <algorithm>
 
 #include "lexer/lexer.h"
+#include "lexer/scan.h"
+#include "interpreter/threadPool.h"
+
+// Sources smaller than this are lexed on a single thread
+static constexpr size_t parallelThreshold = 1 << 20;
+
+int Lexer::column() const {
+    // Past the end of the source the column of the last character is used
+    size_t i = idx < expr.size() ? idx : expr.size() - 1;
+    return (int) (i + 1 - lineStart);
+}
 
 void Lexer::advance() {
     if (currentChar == '\n') {
         line++;
-        column = 0;
+        lineStart = idx + 1;
     }
 
-    if (++idx >= expr->size()) return;
+    if (++idx >= expr.size()) return;
 
-    currentChar = (*expr)[idx];
-    column++;
+    currentChar = expr[idx];
 }
 
-Lexer::Lexer(std::string *expr)
+void Lexer::jump(size_t newIdx) {
+    idx = newIdx;
+    if (idx < expr.size()) currentChar = expr[idx];
+}
+
+Lexer::Lexer(std::string_view expr)
 {
     setExpr(expr);
 }
 
-void Lexer::setExpr(std::string *_expr) {
-    _expr->erase(std::remove(_expr->begin(), _expr->end(), '\r'), _expr->end());
+void Lexer::setExpr(std::string_view _expr) {
     expr = _expr;
     idx = SIZE_MAX; // overflow to 0 on advance()
     currentChar = 0;
     line = 1;
-    column = 0;
+    lineStart = 0;
     advance();
 }
 
 char Lexer::getNextChar(size_t n) {
-    if (idx + n >= expr->size()) return 0;
-    return (*expr)[idx + n];
+    if (idx + n >= expr.size()) return 0;
+    return expr[idx + n];
 }
 
-const std::vector<Token*> Lexer::makeTokens() {
-    size_t reserve = expr->size() / 10;
-    if (reserve < 1) reserve = 1;
-    tokens.reserve(reserve);
+std::span<const Token> Lexer::makeTokens() {
+    tokens = &tokenBuffers.emplace_back();
+
+    if (expr.size() >= parallelThreshold && Interpreter::ThreadPool::shared().concurrency() > 1 && lexParallel())
+        return *tokens;
 
-    size_t currentTokensIdx = tokens.size();
-    std::vector<Token*> currentTokens;
+    lex();
+    return *tokens;
+}
+
+// Finds where the next chunk should start, at the first line from start on that begins a routine
+static size_t findChunkStart(std::string_view source, size_t start) {
+    size_t procedure = source.find("\nPROCEDURE ", start);
+    size_t function = source.find("\nFUNCTION ", start);
+    size_t next = std::min(procedure, function);
+    return next == std::string_view::npos ? source.size() : next + 1;
+}
+
+bool Lexer::lexParallel() {
+    Interpreter::ThreadPool &pool = Interpreter::ThreadPool::shared();
 
-    while (idx < expr->size()) {
+    // A few chunks per thread, so one slow chunk doesn't hold up the rest
+    size_t target = std::max(expr.size() / (pool.concurrency() * 4), parallelThreshold / 4);
+    std::vector<std::string_view> chunks;
+    for (size_t start = 0; start < expr.size(); ) {
+        size_t end = findChunkStart(expr, std::min(start + target, expr.size()));
+        chunks.push_back(expr.substr(start, end - start));
+        start = end;
+    }
+    if (chunks.size() < 2) return false;
+
+    // Chunks always start on a new line, so only line numbers need to be corrected.
+    // A chunk boundary inside a token (such as a string spanning lines) makes the chunk
+    // before it fail, so every chunk lexing successfully means they match a serial run.
+    std::vector<Lexer> lexers(chunks.size());
+    bool failed = false;
+    try {
+        pool.run(chunks.size(), [&](size_t i) {
+            lexers[i].setExpr(chunks[i]);
+            lexers[i].tokens = &lexers[i].tokenBuffers.emplace_back();
+            lexers[i].lex();
+        });
+    } catch (const Interpreter::Error&) {
+        failed = true;
+    }
+    if (failed) return false;
+
+    // Each chunk ends with its own EXPRESSION_END, only the last one is kept
+    std::vector<size_t> offsets(chunks.size() + 1, 0);
+    std::vector<int> lineOffsets(chunks.size(), 0);
+    for (size_t i = 0; i < chunks.size(); i++) {
+        size_t count = lexers[i].tokens->size() - (i + 1 < chunks.size());
+        offsets[i + 1] = offsets[i] + count;
+        if (i + 1 < chunks.size()) lineOffsets[i + 1] = lineOffsets[i] + lexers[i].line - 1;
+    }
+
+    tokens->resize(offsets.back(), Token(TokenType::EXPRESSION_END, 0, 0));
+    pool.run(chunks.size(), [&](size_t i) {
+        Token *out = tokens->data() + offsets[i];
+        for (size_t j = 0; j < offsets[i + 1] - offsets[i]; j++) {
+            const Token &token = (*lexers[i].tokens)[j];
+            out[j] = Token(token.type, token.line + lineOffsets[i], token.column, token.value);
+        }
+    });
+
+    line = lexers.back().line + lineOffsets.back();
+    lineStart = expr.size() - lexers.back().expr.size() + lexers.back().lineStart;
+    idx = expr.size();
+    for (Lexer &lexer : lexers) chunkLiterals.push_back(std::move(lexer.literals));
+    return true;
+}
+
+void Lexer::lex() {
+    size_t reserve = expr.size() / 4;
+    if (reserve < 1) reserve = 1;
+    tokens->reserve(reserve);
+
+    while (idx < expr.size()) {
         if (currentChar == '+') {
-            tokens.emplace_back(new Token(TokenType::PLUS, line, column));
+            tokens->emplace_back(TokenType::PLUS, line, column());
         } else if (currentChar == '-') {
-            tokens.emplace_back(new Token(TokenType::MINUS, line, column));
+            tokens->emplace_back(TokenType::MINUS, line, column());
         } else if (currentChar == '*') {
-            tokens.emplace_back(new Token(TokenType::STAR, line, column));
+            tokens->emplace_back(TokenType::STAR, line, column());
         } else if (currentChar == '/') {
             advance();
-            if (idx >= expr->size() || currentChar != '/') {
-                tokens.emplace_back(new Token(TokenType::SLASH, line, column));
+            if (idx >= expr.size() || currentChar != '/') {
+                tokens->emplace_back(TokenType::SLASH, line, column());
             } else {
-                int commentLine = line;
-                while (line == commentLine && idx < expr->size()) advance();
+                // Comments run up to and including the newline
+                jump(findLineEnd(expr.data() + idx, expr.data() + expr.size()) - expr.data());
+                if (idx < expr.size()) advance();
             }
             continue;
         } else if (currentChar == '(') {
-            tokens.emplace_back(new Token(TokenType::LPAREN, line, column));
+            tokens->emplace_back(TokenType::LPAREN, line, column());
         } else if (currentChar == ')') {
-            tokens.emplace_back(new Token(TokenType::RPAREN, line, column));
+            tokens->emplace_back(TokenType::RPAREN, line, column());
         } else if (currentChar == '[') {
-            tokens.emplace_back(new Token(TokenType::LSQRBRACKET, line, column));
+            tokens->emplace_back(TokenType::LSQRBRACKET, line, column());
         } else if (currentChar == ']') {
-            tokens.emplace_back(new Token(TokenType::RSQRBRACKET, line, column));
+            tokens->emplace_back(TokenType::RSQRBRACKET, line, column());
         } else if (currentChar == '=') {
-            tokens.emplace_back(new Token(TokenType::EQUALS, line, column));
+            tokens->emplace_back(TokenType::EQUALS, line, column());
         } else if (currentChar == ':') {
-            tokens.emplace_back(new Token(TokenType::COLON, line, column));
+            tokens->emplace_back(TokenType::COLON, line, column());
         } else if (currentChar == ',') {
-            tokens.emplace_back(new Token(TokenType::COMMA, line, column));
+            tokens->emplace_back(TokenType::COMMA, line, column());
         } else if (currentChar == '&') {
-            tokens.emplace_back(new Token(TokenType::AMPERSAND, line, column));
+            tokens->emplace_back(TokenType::AMPERSAND, line, column());
         } else if (currentChar == '^') {
-            tokens.emplace_back(new Token(TokenType::CARET, line, column));
+            tokens->emplace_back(TokenType::CARET, line, column());
         } else if (currentChar == '.') {
-            tokens.emplace_back(new Token(TokenType::PERIOD, line, column));
+            tokens->emplace_back(TokenType::PERIOD, line, column());
         } else if (currentChar == '\'') {
             makeChar();
             continue;
@@ -88,24 +171,24 @@ const std::vector<Token*> Lexer::makeTokens() {
         } else if (currentChar == '>') {
             advance();
 
-            if (idx >= expr->size() || currentChar != '=') {
-                tokens.emplace_back(new Token(TokenType::GREATER, line, column));
+            if (idx >= expr.size() || currentChar != '=') {
+                tokens->emplace_back(TokenType::GREATER, line, column());
                 continue;
             } else {
-                tokens.emplace_back(new Token(TokenType::GREATER_EQUAL, line, column));
+                tokens->emplace_back(TokenType::GREATER_EQUAL, line, column());
             }
         } else if (currentChar == '<') {
             advance();
 
-            if (idx >= expr->size() || (currentChar != '=' && currentChar != '>' && currentChar != '-')) {
-                tokens.emplace_back(new Token(TokenType::LESSER, line, column));
+            if (idx >= expr.size() || (currentChar != '=' && currentChar != '>' && currentChar != '-')) {
+                tokens->emplace_back(TokenType::LESSER, line, column());
                 continue;
             } else if (currentChar == '=') {
-                tokens.emplace_back(new Token(TokenType::LESSER_EQUAL, line, column));
+                tokens->emplace_back(TokenType::LESSER_EQUAL, line, column());
             } else if (currentChar == '>') {
-                tokens.emplace_back(new Token(TokenType::NOT_EQUALS, line, column));
+                tokens->emplace_back(TokenType::NOT_EQUALS, line, column());
             } else {
-                tokens.emplace_back(new Token(TokenType::ASSIGNMENT, line, column));
+                tokens->emplace_back(TokenType::ASSIGNMENT, line, column());
             }
         } else if (isalpha(currentChar)) {
             makeWord();
@@ -114,18 +197,14 @@ const std::vector<Token*> Lexer::makeTokens() {
             makeNumber();
             continue;
         } else if (currentChar == '\n') {
-            tokens.emplace_back(new Token(TokenType::LINE_END, line, column));
-        } else if (currentChar != ' ' && currentChar != '\t') {
-            throw Interpreter::InvalidCharError(line, column, currentChar);
+            tokens->emplace_back(TokenType::LINE_END, line, column());
+        } else if (currentChar == ' ' || currentChar == '\t' || currentChar == '\r') {
+            jump(skipBlanks(expr.data() + idx, expr.data() + expr.size()) - expr.data());
+            continue;
+        } else {
+            throw Interpreter::InvalidCharError(line, column(), currentChar);
         }
         advance();
     }
-    tokens.emplace_back(new Token(TokenType::EXPRESSION_END, line, column));
-
-    currentTokens.reserve(tokens.size() - currentTokensIdx + 1);
-    for (size_t i = currentTokensIdx; i < tokens.size(); i++) {
-        currentTokens.push_back(tokens[i].get());
-    }
-
-    return currentTokens;
+    tokens->emplace_back(TokenType::EXPRESSION_END, line, column());
 }
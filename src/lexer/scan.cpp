@@ -0,0 +1,130 @@
+#include "pch.h"
+#include <bit>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PSEUDOENGINE2_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "lexer/scan.h"
+
+static inline bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+static inline bool isStringStop(char c) {
+    return c == '"' || c == '\\' || c == '\r' || c == '\n';
+}
+
+#if defined(__AVX2__)
+
+static inline __m256i load(const char *p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+const char *skipBlanks(const char *p, const char *end) {
+    // Most runs are a single space between tokens, avoid the vector setup for those
+    if (p == end || !isBlank(*p)) return p;
+    if (++p == end || !isBlank(*p)) return p;
+
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i cr = _mm256_set1_epi8('\r');
+    for (; end - p >= 32; p += 32) {
+        __m256i v = load(p);
+        __m256i blank = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, space), _mm256_cmpeq_epi8(v, tab)),
+            _mm256_cmpeq_epi8(v, cr)
+        );
+        unsigned mask = ~static_cast<unsigned>(_mm256_movemask_epi8(blank));
+        if (mask != 0) return p + std::countr_zero(mask);
+    }
+    while (p < end && isBlank(*p)) p++;
+    return p;
+}
+
+const char *findStringStop(const char *p, const char *end) {
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i cr = _mm256_set1_epi8('\r');
+    const __m256i lf = _mm256_set1_epi8('\n');
+    for (; end - p >= 32; p += 32) {
+        __m256i v = load(p);
+        __m256i stop = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, cr), _mm256_cmpeq_epi8(v, lf))
+        );
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(stop));
+        if (mask != 0) return p + std::countr_zero(mask);
+    }
+    while (p < end && !isStringStop(*p)) p++;
+    return p;
+}
+
+#elif defined(PSEUDOENGINE2_SSE2)
+
+static inline __m128i load(const char *p) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+
+const char *skipBlanks(const char *p, const char *end) {
+    // Most runs are a single space between tokens, avoid the vector setup for those
+    if (p == end || !isBlank(*p)) return p;
+    if (++p == end || !isBlank(*p)) return p;
+
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i cr = _mm_set1_epi8('\r');
+    for (; end - p >= 16; p += 16) {
+        __m128i v = load(p);
+        __m128i blank = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(v, tab)),
+            _mm_cmpeq_epi8(v, cr)
+        );
+        unsigned mask = ~static_cast<unsigned>(_mm_movemask_epi8(blank)) & 0xFFFF;
+        if (mask != 0) return p + std::countr_zero(mask);
+    }
+    while (p < end && isBlank(*p)) p++;
+    return p;
+}
+
+const char *findStringStop(const char *p, const char *end) {
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i cr = _mm_set1_epi8('\r');
+    const __m128i lf = _mm_set1_epi8('\n');
+    for (; end - p >= 16; p += 16) {
+        __m128i v = load(p);
+        __m128i stop = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+            _mm_or_si128(_mm_cmpeq_epi8(v, cr), _mm_cmpeq_epi8(v, lf))
+        );
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(stop));
+        if (mask != 0) return p + std::countr_zero(mask);
+    }
+    while (p < end && !isStringStop(*p)) p++;
+    return p;
+}
+
+#else
+
+const char *skipBlanks(const char *p, const char *end) {
+    while (p < end && isBlank(*p)) p++;
+    return p;
+}
+
+const char *findStringStop(const char *p, const char *end) {
+    while (p < end && !isStringStop(*p)) p++;
+    return p;
+}
+
+#endif
+
+// memchr is already vectorised by every major C library
+const char *findLineEnd(const char *p, const char *end) {
+    const void *lf = std::memchr(p, '\n', end - p);
+    return lf == nullptr ? end : static_cast<const char*>(lf);
+}
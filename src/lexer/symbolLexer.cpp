@@ -2,159 +2,129 @@
 #include <ctype.h>
 
 #include "lexer/lexer.h"
+#include "lexer/scan.h"
+
+// Keywords are bucketed by length so a word is only compared against the few keywords of the same size
+static TokenType getWordType(std::string_view word) {
+    // All keywords are uppercase
+    if (word[0] < 'A' || word[0] > 'Z') return TokenType::IDENTIFIER;
+
+    switch (word.size()) {
+        case 2:
+            if (word == "OR") return TokenType::OR;
+            if (word == "IF") return TokenType::IF;
+            if (word == "OF") return TokenType::OF;
+            if (word == "DO") return TokenType::DO;
+            if (word == "TO") return TokenType::TO;
+            break;
+        case 3:
+            if (word == "DIV") return TokenType::DIV;
+            if (word == "MOD") return TokenType::MOD;
+            if (word == "AND") return TokenType::AND;
+            if (word == "NOT") return TokenType::NOT;
+            if (word == "FOR") return TokenType::FOR;
+            break;
+        case 4:
+            if (word == "TRUE") return TokenType::TRUE;
+            if (word == "REAL") return TokenType::DATA_TYPE;
+            if (word == "CHAR") return TokenType::DATA_TYPE;
+            if (word == "DATE") return TokenType::DATA_TYPE;
+            if (word == "TYPE") return TokenType::TYPE;
+            if (word == "THEN") return TokenType::THEN;
+            if (word == "ELSE") return TokenType::ELSE;
+            if (word == "CASE") return TokenType::CASE;
+            if (word == "STEP") return TokenType::STEP;
+            if (word == "NEXT") return TokenType::NEXT;
+            if (word == "CALL") return TokenType::CALL;
+            if (word == "READ") return TokenType::READ;
+            if (word == "SEEK") return TokenType::SEEK;
+            break;
+        case 5:
+            if (word == "FALSE") return TokenType::FALSE;
+            if (word == "ARRAY") return TokenType::ARRAY;
+            if (word == "ENDIF") return TokenType::ENDIF;
+            if (word == "WHILE") return TokenType::WHILE;
+            if (word == "UNTIL") return TokenType::UNTIL;
+            if (word == "BREAK") return TokenType::BREAK;
+            if (word == "BYREF") return TokenType::BYREF;
+            if (word == "BYVAL") return TokenType::BYVAL;
+            if (word == "PRINT") return TokenType::OUTPUT;
+            if (word == "INPUT") return TokenType::INPUT;
+            if (word == "WRITE") return TokenType::WRITE;
+            break;
+        case 6:
+            if (word == "STRING") return TokenType::DATA_TYPE;
+            if (word == "REPEAT") return TokenType::REPEAT;
+            if (word == "RETURN") return TokenType::RETURN;
+            if (word == "OUTPUT") return TokenType::OUTPUT;
+            if (word == "APPEND") return TokenType::APPEND;
+            if (word == "RANDOM") return TokenType::RANDOM;
+            if (word == "REDUCE") return TokenType::REDUCE;
+            break;
+        case 7:
+            if (word == "DECLARE") return TokenType::DECLARE;
+            if (word == "LOADCSV") return TokenType::LOADCSV;
+            if (word == "INTEGER") return TokenType::DATA_TYPE;
+            if (word == "BOOLEAN") return TokenType::DATA_TYPE;
+            if (word == "ENDTYPE") return TokenType::ENDTYPE;
+            if (word == "ENDCASE") return TokenType::ENDCASE;
+            if (word == "RETURNS") return TokenType::RETURNS;
+            break;
+        case 8:
+            if (word == "CONSTANT") return TokenType::CONSTANT;
+            if (word == "ENDWHILE") return TokenType::ENDWHILE;
+            if (word == "CONTINUE") return TokenType::CONTINUE;
+            if (word == "FUNCTION") return TokenType::FUNCTION;
+            if (word == "OPENFILE") return TokenType::OPENFILE;
+            if (word == "READFILE") return TokenType::READFILE;
+            if (word == "PARALLEL") return TokenType::PARALLEL;
+            break;
+        case 9:
+            if (word == "OTHERWISE") return TokenType::OTHERWISE;
+            if (word == "PROCEDURE") return TokenType::PROCEDURE;
+            if (word == "WRITEFILE") return TokenType::WRITEFILE;
+            if (word == "CLOSEFILE") return TokenType::CLOSEFILE;
+            if (word == "GETRECORD") return TokenType::GETRECORD;
+            if (word == "PUTRECORD") return TokenType::PUTRECORD;
+            break;
+        case 10:
+            if (word == "PERSISTENT") return TokenType::PERSISTENT;
+            break;
+        case 11:
+            if (word == "ENDFUNCTION") return TokenType::ENDFUNCTION;
+            break;
+        case 12:
+            if (word == "ENDPROCEDURE") return TokenType::ENDPROCEDURE;
+            break;
+    }
+    return TokenType::IDENTIFIER;
+}
 
 void Lexer::makeWord() {
     size_t startIdx = idx;
-    int startColumn = column;
+    int startColumn = column();
 
-    for ( ; idx < expr->size(); advance()) {
+    for ( ; idx < expr.size(); advance()) {
         if (!isalnum(currentChar) && currentChar != '_') {
             break;
         }
     }
 
-    std::string word = expr->substr(startIdx, idx - startIdx);
-    if (word == "DIV") {
-        tokens.emplace_back(new Token(TokenType::DIV, line, startColumn));
-    } else if (word == "MOD") {
-        tokens.emplace_back(new Token(TokenType::MOD, line, startColumn));
-    }
-
-    else if (word == "AND") {
-        tokens.emplace_back(new Token(TokenType::AND, line, startColumn));
-    } else if (word == "OR") {
-        tokens.emplace_back(new Token(TokenType::OR, line, startColumn));
-    } else if (word == "NOT") {
-        tokens.emplace_back(new Token(TokenType::NOT, line, startColumn));
-    } else if (word == "TRUE") {
-        tokens.emplace_back(new Token(TokenType::TRUE, line, startColumn));
-    } else if (word == "FALSE") {
-        tokens.emplace_back(new Token(TokenType::FALSE, line, startColumn));
-    }
-
-    else if (word == "DECLARE") {
-        tokens.emplace_back(new Token(TokenType::DECLARE, line, startColumn));
-    } else if (word == "CONSTANT") {
-        tokens.emplace_back(new Token(TokenType::CONSTANT, line, startColumn));
-    } else if (word == "INTEGER" || word == "REAL" || word == "BOOLEAN" || word == "CHAR" || word == "STRING" || word == "DATE") {
-        tokens.emplace_back(new Token(TokenType::DATA_TYPE, line, startColumn, word));
-    } else if (word == "ARRAY") {
-        tokens.emplace_back(new Token(TokenType::ARRAY, line, startColumn));
-    }
-
-    else if (word == "TYPE") {
-        tokens.emplace_back(new Token(TokenType::TYPE, line, startColumn));
-    } else if (word == "ENDTYPE") {
-        tokens.emplace_back(new Token(TokenType::ENDTYPE, line, startColumn));
-    }
-
-    else if (word == "IF") {
-        tokens.emplace_back(new Token(TokenType::IF, line, startColumn));
-    } else if (word == "THEN") {
-        tokens.emplace_back(new Token(TokenType::THEN, line, startColumn));
-    } else if (word == "ELSE") {
-        tokens.emplace_back(new Token(TokenType::ELSE, line, startColumn));
-    } else if (word == "ENDIF") {
-        tokens.emplace_back(new Token(TokenType::ENDIF, line, startColumn));
-    }
-
-    else if (word == "CASE") {
-        tokens.emplace_back(new Token(TokenType::CASE, line, startColumn));
-    } else if (word == "OF") {
-        tokens.emplace_back(new Token(TokenType::OF, line, startColumn));
-    } else if (word == "OTHERWISE") {
-        tokens.emplace_back(new Token(TokenType::OTHERWISE, line, startColumn));
-    } else if (word == "ENDCASE") {
-        tokens.emplace_back(new Token(TokenType::ENDCASE, line, startColumn));
-    }
-
-    else if (word == "WHILE") {
-        tokens.emplace_back(new Token(TokenType::WHILE, line, startColumn));
-    } else if (word == "DO") {
-        tokens.emplace_back(new Token(TokenType::DO, line, startColumn));
-    } else if (word == "ENDWHILE") {
-        tokens.emplace_back(new Token(TokenType::ENDWHILE, line, startColumn));
-    }
-
-    else if (word == "REPEAT") {
-        tokens.emplace_back(new Token(TokenType::REPEAT, line, startColumn));
-    } else if (word == "UNTIL") {
-        tokens.emplace_back(new Token(TokenType::UNTIL, line, startColumn));
-    }
-
-    else if (word == "FOR") {
-        tokens.emplace_back(new Token(TokenType::FOR, line, startColumn));
-    } else if (word == "TO") {
-        tokens.emplace_back(new Token(TokenType::TO, line, startColumn));
-    } else if (word == "STEP") {
-        tokens.emplace_back(new Token(TokenType::STEP, line, startColumn));
-    } else if (word == "NEXT") {
-        tokens.emplace_back(new Token(TokenType::NEXT, line, startColumn));
-    }
-
-    else if (word == "BREAK") {
-        tokens.emplace_back(new Token(TokenType::BREAK, line, startColumn));
-    } else if (word == "CONTINUE") {
-        tokens.emplace_back(new Token(TokenType::CONTINUE, line, startColumn));
-    }
-
-    else if (word == "PROCEDURE") {
-        tokens.emplace_back(new Token(TokenType::PROCEDURE, line, startColumn));
-    } else if (word == "BYREF") {
-        tokens.emplace_back(new Token(TokenType::BYREF, line, startColumn));
-    } else if (word == "BYVAL") {
-        tokens.emplace_back(new Token(TokenType::BYVAL, line, startColumn));
-    } else if (word == "ENDPROCEDURE") {
-        tokens.emplace_back(new Token(TokenType::ENDPROCEDURE, line, startColumn));
-    } else if (word == "CALL") {
-        tokens.emplace_back(new Token(TokenType::CALL, line, startColumn));
-    }
-
-    else if (word == "FUNCTION") {
-        tokens.emplace_back(new Token(TokenType::FUNCTION, line, startColumn));
-    } else if (word == "ENDFUNCTION") {
-        tokens.emplace_back(new Token(TokenType::ENDFUNCTION, line, startColumn));
-    } else if (word == "RETURNS") {
-        tokens.emplace_back(new Token(TokenType::RETURNS, line, startColumn));
-    } else if (word == "RETURN") {
-        tokens.emplace_back(new Token(TokenType::RETURN, line, startColumn));
-    }
-
-    else if (word == "OUTPUT" || word == "PRINT") {
-        tokens.emplace_back(new Token(TokenType::OUTPUT, line, startColumn));
-    } else if (word == "INPUT") {
-        tokens.emplace_back(new Token(TokenType::INPUT, line, startColumn));
-    }
-
-    else if (word == "OPENFILE") {
-        tokens.emplace_back(new Token(TokenType::OPENFILE, line, startColumn));
-    } else if (word == "READFILE") {
-        tokens.emplace_back(new Token(TokenType::READFILE, line, startColumn));
-    } else if (word == "WRITEFILE") {
-        tokens.emplace_back(new Token(TokenType::WRITEFILE, line, startColumn));
-    } else if (word == "CLOSEFILE") {
-        tokens.emplace_back(new Token(TokenType::CLOSEFILE, line, startColumn));
-    }
-
-    else if (word == "READ") {
-        tokens.emplace_back(new Token(TokenType::READ, line, startColumn));
-    } else if (word == "WRITE") {
-        tokens.emplace_back(new Token(TokenType::WRITE, line, startColumn));
-    } else if (word == "APPEND") {
-        tokens.emplace_back(new Token(TokenType::APPEND, line, startColumn));
-    }
-
-    else {
-        tokens.emplace_back(new Token(TokenType::IDENTIFIER, line, startColumn, word));
+    std::string_view word = expr.substr(startIdx, idx - startIdx);
+    TokenType type = getWordType(word);
+    if (type == TokenType::IDENTIFIER || type == TokenType::DATA_TYPE) {
+        tokens->emplace_back(type, line, startColumn, word);
+    } else {
+        tokens->emplace_back(type, line, startColumn);
     }
 }
 
 void Lexer::makeNumber() {
     int startIdx = idx;
-    int startColumn = column;
+    int startColumn = column();
     bool decimal = false;
 
-    for ( ; idx < expr->size(); advance()) {
+    for ( ; idx < expr.size(); advance()) {
         if (currentChar == '.' && !decimal) {
             decimal = true;
             continue;
@@ -163,7 +133,7 @@ void Lexer::makeNumber() {
     }
 
     TokenType type = decimal ? TokenType::REAL : TokenType::INTEGER;
-    tokens.emplace_back(new Token(type, line, startColumn, expr->substr(startIdx, idx - startIdx)));
+    tokens->emplace_back(type, line, startColumn, expr.substr(startIdx, idx - startIdx));
     // Check for date
     if (currentChar != '/' || decimal) return;
 
@@ -173,9 +143,9 @@ void Lexer::makeNumber() {
     if (c != '/' || !isdigit(c = getNextChar(++i))) return;
 
     for (int j = 0; j < i; j++) advance();
-    while (isdigit(currentChar) && idx < expr->size()) advance();
-    tokens.pop_back();
-    tokens.emplace_back(new Token(TokenType::DATE, line, startColumn, expr->substr(startIdx, idx - startIdx)));
+    while (isdigit(currentChar) && idx < expr.size()) advance();
+    tokens->pop_back();
+    tokens->emplace_back(TokenType::DATE, line, startColumn, expr.substr(startIdx, idx - startIdx));
 }
 
 char escSeqFmt(char code) {
@@ -196,53 +166,69 @@ char escSeqFmt(char code) {
 }
 
 void Lexer::makeChar() {
-    if (idx + 2 >= expr->size()) 
-        throw Interpreter::LexerError(line, column, "Char must contain at least once character");
+    if (idx + 2 >= expr.size()) 
+        throw Interpreter::LexerError(line, column(), "Char must contain at least once character");
 
-    int startColumn = column;
+    int startColumn = column();
     advance();
     char c;
 
     if (currentChar == '\\') {
         advance();
         c = escSeqFmt(currentChar);
-        if (c == -1) throw Interpreter::LexerError(line, column, "Invalid escape sequence");
+        if (c == -1) throw Interpreter::LexerError(line, column(), "Invalid escape sequence");
     } else if (currentChar == '\'') {
-        throw Interpreter::LexerError(line, column, "Char must contain at least once character");
+        throw Interpreter::LexerError(line, column(), "Char must contain at least once character");
     } else {
         c = currentChar;
     }
 
-    if (idx + 1 >= expr->size() || (*expr)[idx + 1] != '\'')
-        throw Interpreter::ExpectedQuotesError(line, column, false);
+    if (idx + 1 >= expr.size() || expr[idx + 1] != '\'')
+        throw Interpreter::ExpectedQuotesError(line, column(), false);
+
+    std::string_view value;
+    if (c == currentChar) value = expr.substr(idx, 1);
+    else value = literals.emplace_back(1, c);
     advance();
     advance();
 
-    std::string str;
-    str += c;
-    tokens.emplace_back(new Token(TokenType::CHAR, line, startColumn, str));
+    tokens->emplace_back(TokenType::CHAR, line, startColumn, value);
 }
 
 void Lexer::makeString() {
-    int startColumn = column;
+    int startColumn = column();
     advance();
 
-    std::string str;
-    while (currentChar != '"' && idx < expr->size()) {
-        if (currentChar == '\\') {
-            advance();
-            char c = escSeqFmt(currentChar);
-            if (c == -1) throw Interpreter::LexerError(line, column, "Invalid escape sequence");
-            str += c;
-        } else {
-            str += currentChar;
+    // Only strings with escape sequences or carriage returns need to be copied,
+    // all others are referenced directly from the source
+    size_t startIdx = idx;
+    std::string *str = nullptr;
+    while (idx < expr.size()) {
+        // Skip over plain contents in one go, stopping at anything that needs handling
+        size_t stop = findStringStop(expr.data() + idx, expr.data() + expr.size()) - expr.data();
+        if (str != nullptr) str->append(expr.substr(idx, stop - idx));
+        jump(stop);
+        if (idx >= expr.size() || currentChar == '"') break;
+
+        if (currentChar == '\\' || currentChar == '\r') {
+            if (str == nullptr) str = &literals.emplace_back(expr.substr(startIdx, idx - startIdx));
+            if (currentChar == '\\') {
+                advance();
+                char c = escSeqFmt(currentChar);
+                if (c == -1) throw Interpreter::LexerError(line, column(), "Invalid escape sequence");
+                *str += c;
+            }
+        } else if (str != nullptr) {
+            *str += currentChar;
         }
         advance();
     }
 
-    if (idx >= expr->size() || currentChar != '"')
-        throw Interpreter::ExpectedQuotesError(line, column, true);
+    if (idx >= expr.size() || currentChar != '"')
+        throw Interpreter::ExpectedQuotesError(line, column(), true);
+
+    std::string_view value = str == nullptr ? expr.substr(startIdx, idx - startIdx) : *str;
     advance();
 
-    tokens.emplace_back(new Token(TokenType::STRING, line, startColumn, str));
+    tokens->emplace_back(TokenType::STRING, line, startColumn, value);
 }
@@ -2,7 +2,7 @@
 
 #include "lexer/tokens.h"
 
-Token::Token(const TokenType &type, int line, int column, const std::string &value)
+Token::Token(const TokenType &type, int line, int column, std::string_view value)
     : type(type), line(line), column(column), value(value)
 {}
 
@@ -99,10 +99,18 @@ static const char *TT_STR[] = {
     "TT_READFILE",
     "TT_WRITEFILE",
     "TT_CLOSEFILE",
+    "TT_SEEK",
+    "TT_GETRECORD",
+    "TT_PUTRECORD",
+    "TT_LOADCSV",
+    "TT_PERSISTENT",
+    "TT_PARALLEL",
+    "TT_REDUCE",
 
     "TT_READ",
     "TT_WRITE",
     "TT_APPEND",
+    "TT_RANDOM",
 
     "TT_LINE_END",
     "TT_EXPRESSION_END"
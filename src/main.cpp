@@ -1,35 +1,37 @@
 #include "pch.h"
 #include <string>
-#include <ctime>
-#include <stdlib.h>
 
 #include "launch/run.h"
+#include "interpreter/output.h"
 
-bool REPLMode = true;
+static void printUsage(const char *program) {
+    std::cerr << "Usage:\n" << program << " <filename>\n"
+        << program << " --batch <manifest> <results>\n"
+        << program << " --inputs <directory> <filename>" << std::endl;
+}
 
 int main(int argc, char **argv) {
-	// `/dev/random` only exists on Unix.
-#ifndef WIN32
-	std::FILE *fd = std::fopen("/dev/random", "r");
-	unsigned int seed = 0;
-	// Read the first 4 bytes of /dev/random into an unsigned integer so that we can seed the random number generator.
-	fread(&seed, 4, 1, fd);
-	fclose(fd);
-	srand(seed);
-#else
-	// FIXME: Better seeding on the niche gaming operating system Microsoft Windows.
-	srand((unsigned int) time(nullptr));
-#endif
+	Interpreter::OutputBuffer output;
+
 	bool status;
+    std::string_view option = argc > 1 ? argv[1] : "";
 	if (argc == 1) {
 		status = startREPL();
-	}
-    if (argc == 2) {
-        REPLMode = false;
+	} else if (option == "--batch" || option == "--inputs") {
+        if (argc != 4) {
+            std::cerr << option << " takes two arguments!\n";
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+        if (option == "--batch") status = runBatch(argv[2], argv[3]);
+        else status = runInputs(argv[3], argv[2]);
+    } else if (argc == 2) {
 		std::filesystem::path filepath(argv[1]);
-        status = runFile(filepath);
-    } else if (argc > 2) {
-        std::cerr << "Too many arguments!\nUsage:\n" << argv[0] << " <filename>" << std::endl;
+        Interpreter::Instance instance(filepath.string());
+        status = runFile(filepath, instance);
+    } else {
+        std::cerr << "Too many arguments!\n";
+        printUsage(argv[0]);
         return EXIT_FAILURE;
     }
 
@@ -4,14 +4,24 @@
 
 #include <chrono>
 #include <memory>
+#include <charconv>
 #include "interpreter/error.h"
 #include "nodes/eval/arithmetic.h"
 #include "interpreter/types/datatypes.h"
 #include "interpreter/types/type_definitions.h"
 #include "interpreter/types/types.h"
 
+template<typename T>
+inline T parseNumber(const Token &token) {
+    T value{};
+    auto [ptr, ec] = std::from_chars(token.value.data(), token.value.data() + token.value.size(), value);
+    if (ec != std::errc())
+        throw Interpreter::SyntaxError(token, "Number out of range");
+    return value;
+}
+
 IntegerNode::IntegerNode(const Token &token)
-    : Node(token), valueInt(std::stol(token.value))
+    : Node(token), valueInt(parseNumber<Interpreter::int_t>(token))
 {}
 
 std::unique_ptr<NodeResult> IntegerNode::evaluate(Interpreter::Context&) {
@@ -20,7 +30,7 @@ std::unique_ptr<NodeResult> IntegerNode::evaluate(Interpreter::Context&) {
 
 
 RealNode::RealNode(const Token &token)
-    : Node(token), valueReal(std::stod(token.value))
+    : Node(token), valueReal(parseNumber<Interpreter::real_t>(token))
 {}
 
 std::unique_ptr<NodeResult> RealNode::evaluate(Interpreter::Context&) {
@@ -37,14 +47,14 @@ std::unique_ptr<NodeResult> CharNode::evaluate(Interpreter::Context&) {
 }
 
 StringNode::StringNode(const Token &token)
-    : Node(token), valueStr(token.value)
+    : Node(token), valueStr(std::string(token.value))
 {}
 
 std::unique_ptr<NodeResult> StringNode::evaluate(Interpreter::Context&) {
     return std::make_unique<NodeResult>(new Interpreter::String(valueStr), Interpreter::DataType::STRING);
 }
 
-inline Interpreter::Date makeDate(const std::string &dateStr) {
+inline Interpreter::Date makeDate(std::string_view dateStr) {
     std::string dayStr, monthStr, yearStr;
     int x = 0;
     for (char c : dateStr) {
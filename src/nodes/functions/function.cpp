@@ -8,7 +8,7 @@
 
 FunctionNode::FunctionNode(
 		const Token &token,
-		const std::string &functionName,
+		std::string_view functionName,
 		std::vector<std::string> &&parameterNames,
 		std::vector<const Token*> &&parameterTypes,
 		std::vector<bool> &&parameterPassTypes,
@@ -30,7 +30,7 @@ std::unique_ptr<NodeResult> FunctionNode::evaluate(Interpreter::Context &ctx) {
 
     Interpreter::DataType returnDataType = ctx.getType(returnType);
     if (returnDataType == Interpreter::DataType::NONE)
-        throw Interpreter::NotDefinedError(returnType, ctx, "Type '" + returnType.value + "'");
+        throw Interpreter::NotDefinedError(returnType, ctx, "Type '" + std::string(returnType.value) + "'");
 
     size_t parametersSize = parameterNames.size();
     std::vector<Interpreter::Parameter> parameters;
@@ -39,7 +39,7 @@ std::unique_ptr<NodeResult> FunctionNode::evaluate(Interpreter::Context &ctx) {
         const Token *typeToken = parameterTypes[i];
         Interpreter::DataType type = ctx.getType(*typeToken);
         if (type == Interpreter::DataType::NONE)
-            throw Interpreter::NotDefinedError(*typeToken, ctx, "Type '" + typeToken->value + "'");
+            throw Interpreter::NotDefinedError(*typeToken, ctx, "Type '" + std::string(typeToken->value) + "'");
         parameters.emplace_back(parameterNames[i], type, parameterPassTypes[i]);
     }
 
@@ -50,8 +50,8 @@ std::unique_ptr<NodeResult> FunctionNode::evaluate(Interpreter::Context &ctx) {
 }
 
 
-FunctionCallNode::FunctionCallNode(const Token &token, std::vector<Node*> &&args)
-    : Node(token), functionName(token.value), args(std::move(args))
+FunctionCallNode::FunctionCallNode(const Token &token, std::span<Node *const> args)
+    : Node(token), functionName(token.value), args(args)
 {}
 
 std::unique_ptr<NodeResult> FunctionCallNode::evaluate(Interpreter::Context &ctx) {
@@ -74,6 +74,10 @@ std::unique_ptr<NodeResult> FunctionCallNode::evaluate(Interpreter::Context &ctx
     if (args.size() != nArgs)
         throw Interpreter::InvalidArgsError(token, ctx, function->getTypes(), std::move(argTypes));
 
+    size_t maxCallDepth = ctx.getInstance().getMaxCallDepth();
+    if (maxCallDepth != 0 && ctx.getDepth() >= maxCallDepth)
+        throw Interpreter::RuntimeError(token, ctx, "Calls nested more than " + std::to_string(maxCallDepth) + " deep, possibly endless recursion");
+
     auto functionCtx = std::make_unique<Interpreter::Context>(&ctx, functionName, true, function->returnType);
     ctx.switchToken = &token;
 
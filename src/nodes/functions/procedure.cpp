@@ -8,7 +8,7 @@
 
 ProcedureNode::ProcedureNode(
 		const Token &token,
-		const std::string &procedureName,
+		std::string_view procedureName,
 		std::vector<std::string> &&parameterNames,
 		std::vector<const Token*> &&parameterTypes,
 		std::vector<bool> &&parameterPassTypes,
@@ -33,7 +33,7 @@ std::unique_ptr<NodeResult> ProcedureNode::evaluate(Interpreter::Context &ctx) {
         const Token *typeToken = parameterTypes[i];
         Interpreter::DataType type = ctx.getType(*typeToken);
         if (type == Interpreter::DataType::NONE)
-            throw Interpreter::NotDefinedError(*typeToken, ctx, "Type '" + typeToken->value + "'");
+            throw Interpreter::NotDefinedError(*typeToken, ctx, "Type '" + std::string(typeToken->value) + "'");
         parameters.emplace_back(parameterNames[i], type, parameterPassTypes[i]);
     }
 
@@ -44,8 +44,8 @@ std::unique_ptr<NodeResult> ProcedureNode::evaluate(Interpreter::Context &ctx) {
 }
 
 
-CallNode::CallNode(const Token &token, const std::string &procedureName, std::vector<Node*> &&args)
-    : Node(token), procedureName(procedureName), args(std::move(args))
+CallNode::CallNode(const Token &token, std::string_view procedureName, std::span<Node *const> args)
+    : Node(token), procedureName(procedureName), args(args)
 {}
 
 std::unique_ptr<NodeResult> CallNode::evaluate(Interpreter::Context &ctx) {
@@ -68,6 +68,10 @@ std::unique_ptr<NodeResult> CallNode::evaluate(Interpreter::Context &ctx) {
     if (args.size() != nArgs)
         throw Interpreter::InvalidArgsError(token, ctx, procedure->getTypes(), std::move(argTypes));
 
+    size_t maxCallDepth = ctx.getInstance().getMaxCallDepth();
+    if (maxCallDepth != 0 && ctx.getDepth() >= maxCallDepth)
+        throw Interpreter::RuntimeError(token, ctx, "Calls nested more than " + std::to_string(maxCallDepth) + " deep, possibly endless recursion");
+
     auto procedureCtx = std::make_unique<Interpreter::Context>(&ctx, procedureName);
     ctx.switchToken = &token;
 
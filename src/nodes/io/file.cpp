@@ -1,8 +1,14 @@
 #include "pch.h"
+#include <algorithm>
+#include <charconv>
 
 #include "nodes/io/file.h"
 #include "interpreter/error.h"
 #include "interpreter/file.h"
+#include "interpreter/record.h"
+#include "interpreter/csv.h"
+#include "interpreter/array.h"
+#include "interpreter/source.h"
 
 OpenFileNode::OpenFileNode(const Token &token, Node &filename, Interpreter::FileMode mode)
     : Node(token), mode(mode), filename(filename) {}
@@ -26,8 +32,8 @@ std::unique_ptr<NodeResult> OpenFileNode::evaluate(Interpreter::Context &ctx) {
 }
 
 
-ReadFileNode::ReadFileNode(const Token &token, Node &filename, const Token &identifier)
-    : Node(token), filename(filename), identifier(identifier) {}
+ReadFileNode::ReadFileNode(const Token &token, Node &filename, const Token &identifier, size_t fileSite)
+    : Node(token), filename(filename), identifier(identifier), fileSite(fileSite) {}
 
 std::unique_ptr<NodeResult> ReadFileNode::evaluate(Interpreter::Context &ctx) {
     auto filenameRes = filename.evaluate(ctx);
@@ -36,27 +42,27 @@ std::unique_ptr<NodeResult> ReadFileNode::evaluate(Interpreter::Context &ctx) {
     
     Interpreter::Variable *var = ctx.getVariable(identifier.value);
     if (var == nullptr) {
-        var = new Interpreter::Variable(identifier.value, Interpreter::DataType::STRING, false, &ctx);
+        var = new Interpreter::Variable(std::string(identifier.value), Interpreter::DataType::STRING, false, &ctx);
         ctx.addVariable(var);
     }
     if (var->type != Interpreter::DataType::STRING)
         throw Interpreter::RuntimeError(token, ctx, "Variable of type STRING expected");
 
     auto &filename = filenameRes->get<Interpreter::String>();
-    Interpreter::File *file = ctx.getFileManager().getFile(filename);
+    Interpreter::File *file = ctx.getFileManager().getFile(filename, fileSite);
     if (file == nullptr)
         throw Interpreter::FileNotOpenError(token, ctx, filename.value);
+    if (file->getMode() == Interpreter::FileMode::RANDOM)
+        throw Interpreter::RuntimeError(token, ctx, "File '" + filename.value + "' is opened for RANDOM access");
     
-    Interpreter::String *data = new Interpreter::String;
-    *data = file->read();
-    var->set(data);
+    var->get<Interpreter::String>().value = file->read();
 
     return std::make_unique<NodeResult>(nullptr, Interpreter::DataType::NONE);
 }
 
 
-WriteFileNode::WriteFileNode(const Token &token, Node &filename, Node &node)
-    : UnaryNode(token, node), filename(filename) {}
+WriteFileNode::WriteFileNode(const Token &token, Node &filename, Node &node, size_t fileSite)
+    : UnaryNode(token, node), filename(filename), fileSite(fileSite) {}
 
 std::unique_ptr<NodeResult> WriteFileNode::evaluate(Interpreter::Context &ctx) {
     auto filenameRes = filename.evaluate(ctx);
@@ -64,33 +70,37 @@ std::unique_ptr<NodeResult> WriteFileNode::evaluate(Interpreter::Context &ctx) {
         throw Interpreter::RuntimeError(token, ctx, "Expected string for file name");
     
     auto &filename = filenameRes->get<Interpreter::String>();
-    Interpreter::File *file = ctx.getFileManager().getFile(filename);
+    Interpreter::File *file = ctx.getFileManager().getFile(filename, fileSite);
     if (file == nullptr)
         throw Interpreter::FileNotOpenError(token, ctx, filename.value);
     if (file->getMode() == Interpreter::FileMode::READ)
         throw Interpreter::RuntimeError(token, ctx, "File '" + filename.value + "' is opened as read-only");
+    if (file->getMode() == Interpreter::FileMode::RANDOM)
+        throw Interpreter::RuntimeError(token, ctx, "File '" + filename.value + "' is opened for RANDOM access");
 
+    // Values are formatted into a local buffer and copied straight into the file's buffer
     auto nodeRes = node.evaluate(ctx);
-    std::unique_ptr<Interpreter::String> data;
+    char buffer[std::max<size_t>(Interpreter::Real::formatSize, 24)];
     switch (nodeRes->type.type) {
-        case Interpreter::DataType::INTEGER:
-            data = nodeRes->get<Interpreter::Integer>().toString();
+        case Interpreter::DataType::INTEGER: {
+            char *end = std::to_chars(buffer, buffer + sizeof(buffer), nodeRes->get<Interpreter::Integer>().value).ptr;
+            file->write(std::string_view(buffer, end - buffer));
             break;
-        case Interpreter::DataType::REAL:
-            data = nodeRes->get<Interpreter::Real>().toString();
+        } case Interpreter::DataType::REAL:
+            file->write(std::string_view(buffer, Interpreter::Real::format(nodeRes->get<Interpreter::Real>(), buffer, false)));
             break;
         case Interpreter::DataType::BOOLEAN:
-            data = nodeRes->get<Interpreter::Boolean>().toString();
+            file->write(nodeRes->get<Interpreter::Boolean>() ? "TRUE" : "FALSE");
             break;
         case Interpreter::DataType::CHAR:
-            data = nodeRes->get<Interpreter::Char>().toString();
+            buffer[0] = nodeRes->get<Interpreter::Char>();
+            file->write(std::string_view(buffer, 1));
             break;
-        case Interpreter::DataType::STRING: {
-            auto str = nodeRes->get<Interpreter::String>();
-            data = std::make_unique<Interpreter::String>(str);
+        case Interpreter::DataType::STRING:
+            file->write(nodeRes->get<Interpreter::String>().value);
             break;
-        } case Interpreter::DataType::DATE:
-            data = nodeRes->get<Interpreter::Date>().toString();
+        case Interpreter::DataType::DATE:
+            file->write(nodeRes->get<Interpreter::Date>().toString()->value);
             break;
         case Interpreter::DataType::NONE:
             throw Interpreter::RuntimeError(token, ctx, "Expected value for writing");
@@ -100,14 +110,12 @@ std::unique_ptr<NodeResult> WriteFileNode::evaluate(Interpreter::Context &ctx) {
             throw Interpreter::TypeOperationError(token, ctx, "Write");
     }
 
-    file->write(*data);
-
     return std::make_unique<NodeResult>(nullptr, Interpreter::DataType::NONE);
 }
 
 
-CloseFileNode::CloseFileNode(const Token &token, Node &filename)
-    : Node(token), filename(filename) {}
+CloseFileNode::CloseFileNode(const Token &token, Node &filename, size_t fileSite)
+    : Node(token), filename(filename), fileSite(fileSite) {}
 
 std::unique_ptr<NodeResult> CloseFileNode::evaluate(Interpreter::Context &ctx) {
     auto filenameRes = filename.evaluate(ctx);
@@ -115,7 +123,7 @@ std::unique_ptr<NodeResult> CloseFileNode::evaluate(Interpreter::Context &ctx) {
         throw Interpreter::RuntimeError(token, ctx, "Expected string for file name");
     
     auto &filename = filenameRes->get<Interpreter::String>();
-    Interpreter::File *file = ctx.getFileManager().getFile(filename);
+    Interpreter::File *file = ctx.getFileManager().getFile(filename, fileSite);
     if (file == nullptr)
         throw Interpreter::FileNotOpenError(token, ctx, filename.value);
 
@@ -123,3 +131,156 @@ std::unique_ptr<NodeResult> CloseFileNode::evaluate(Interpreter::Context &ctx) {
 
     return std::make_unique<NodeResult>(nullptr, Interpreter::DataType::NONE);
 }
+
+
+SeekNode::SeekNode(const Token &token, Node &filename, Node &node, size_t fileSite)
+    : UnaryNode(token, node), filename(filename), fileSite(fileSite) {}
+
+std::unique_ptr<NodeResult> SeekNode::evaluate(Interpreter::Context &ctx) {
+    auto filenameRes = filename.evaluate(ctx);
+    if (filenameRes->type != Interpreter::DataType::STRING)
+        throw Interpreter::RuntimeError(token, ctx, "Expected string for file name");
+
+    auto &filename = filenameRes->get<Interpreter::String>();
+    Interpreter::File *file = ctx.getFileManager().getFile(filename, fileSite);
+    if (file == nullptr)
+        throw Interpreter::FileNotOpenError(token, ctx, filename.value);
+    if (file->getMode() != Interpreter::FileMode::RANDOM)
+        throw Interpreter::RuntimeError(token, ctx, "File '" + filename.value + "' is not opened for RANDOM access");
+
+    auto addressRes = node.evaluate(ctx);
+    if (addressRes->type != Interpreter::DataType::INTEGER)
+        throw Interpreter::RuntimeError(token, ctx, "Expected integer for record address");
+    Interpreter::int_t address = addressRes->get<Interpreter::Integer>().value;
+    if (address < 1)
+        throw Interpreter::RuntimeError(token, ctx, "Record address must be at least 1");
+
+    file->seek(address - 1);
+
+    return std::make_unique<NodeResult>(nullptr, Interpreter::DataType::NONE);
+}
+
+
+RecordNode::RecordNode(const Token &token, Node &filename, const AbstractVariableResolver &resolver, size_t fileSite)
+    : Node(token), filename(filename), resolver(resolver), fileSite(fileSite) {}
+
+std::unique_ptr<NodeResult> RecordNode::evaluate(Interpreter::Context &ctx) {
+    auto filenameRes = filename.evaluate(ctx);
+    if (filenameRes->type != Interpreter::DataType::STRING)
+        throw Interpreter::RuntimeError(token, ctx, "Expected string for file name");
+
+    auto &filename = filenameRes->get<Interpreter::String>();
+    Interpreter::File *file = ctx.getFileManager().getFile(filename, fileSite);
+    if (file == nullptr)
+        throw Interpreter::FileNotOpenError(token, ctx, filename.value);
+    if (file->getMode() != Interpreter::FileMode::RANDOM)
+        throw Interpreter::RuntimeError(token, ctx, "File '" + filename.value + "' is not opened for RANDOM access");
+
+    Interpreter::DataHolder &holder = resolver.resolve(ctx);
+    if (holder.isArray())
+        throw Interpreter::ArrayDirectAccessError(token, ctx);
+    Interpreter::Variable &var = static_cast<Interpreter::Variable&>(holder);
+
+    size_t size = Interpreter::Record::size(var);
+    if (size == 0)
+        throw Interpreter::RuntimeError(token, ctx, "Variable '" + var.name + "' cannot be stored in a record");
+    if (!file->setRecordSize(size))
+        throw Interpreter::RuntimeError(token, ctx, "Record size of '" + var.name + "' does not match the records in '" + filename.value + "'");
+
+    // Records are at most a few KiB unless a composite nests many strings
+    std::string record(size, '\0');
+    if (token.type == TokenType::GETRECORD) {
+        if (var.isConstant)
+            throw Interpreter::ConstAssignError(token, ctx, var.name);
+        if (!file->getRecord(record.data()))
+            throw Interpreter::RuntimeError(token, ctx, "No record to read at this address in '" + filename.value + "'");
+        if (!Interpreter::Record::load(var, record.data(), ctx))
+            throw Interpreter::RuntimeError(token, ctx, "Record in '" + filename.value + "' does not hold a valid value for '" + var.name + "'");
+    } else {
+        if (!Interpreter::Record::store(var, record.data()))
+            throw Interpreter::RuntimeError(token, ctx, "Strings in records are limited to " + std::to_string(Interpreter::Record::maxStringLength) + " characters");
+        if (!file->putRecord(record.data()))
+            throw Interpreter::RuntimeError(token, ctx, "Failed to write record to '" + filename.value + "'");
+    }
+
+    return std::make_unique<NodeResult>(nullptr, Interpreter::DataType::NONE);
+}
+
+
+LoadCsvNode::LoadCsvNode(const Token &token, Node &filename, const AbstractVariableResolver &array, const AbstractVariableResolver *rowCount)
+    : Node(token), filename(filename), array(array), rowCount(rowCount) {}
+
+std::unique_ptr<NodeResult> LoadCsvNode::evaluate(Interpreter::Context &ctx) {
+    auto filenameRes = filename.evaluate(ctx);
+    if (filenameRes->type != Interpreter::DataType::STRING)
+        throw Interpreter::RuntimeError(token, ctx, "Expected string for file name");
+    auto &filename = filenameRes->get<Interpreter::String>();
+
+    Interpreter::DataHolder &holder = array.resolve(ctx);
+    if (!holder.isArray())
+        throw Interpreter::RuntimeError(token, ctx, "Expected array for LOADCSV");
+    Interpreter::Array &arr = static_cast<Interpreter::Array&>(holder);
+
+    Interpreter::Variable *count = nullptr;
+    if (rowCount != nullptr) {
+        Interpreter::DataHolder &countHolder = rowCount->resolve(ctx);
+        if (countHolder.isArray())
+            throw Interpreter::ArrayDirectAccessError(token, ctx);
+        count = static_cast<Interpreter::Variable*>(&countHolder);
+        if (count->type != Interpreter::DataType::INTEGER)
+            throw Interpreter::RuntimeError(token, ctx, "Variable of type INTEGER expected");
+        if (count->isConstant)
+            throw Interpreter::ConstAssignError(token, ctx, count->name);
+    }
+
+    // Each row fills an element of a 1D array or a row of a 2D array. Arrays of composites take a header
+    // row instead, naming the member each column goes to.
+    bool composite = arr.type == Interpreter::DataType::COMPOSITE;
+    if (arr.type == Interpreter::DataType::POINTER || arr.dimensions.size() > 2 || (composite && arr.dimensions.size() == 2))
+        throw Interpreter::RuntimeError(token, ctx, "LOADCSV needs a 1D array, or a 2D array of primitive values");
+    size_t rows = arr.dimensions[0].getSize();
+    size_t columns = arr.dimensions.size() == 2 ? arr.dimensions[1].getSize() : 1;
+
+    Interpreter::SourceFile file;
+    if (!file.copy(filename.value))
+        throw Interpreter::RuntimeError(token, ctx, "Failed to open file '" + filename.value + "'");
+    Interpreter::CsvReader reader(file.view());
+
+    std::vector<size_t> members;
+    if (composite && reader.next()) {
+        const auto &variables = arr.getElementAt(0).get<Interpreter::Composite>().ctx->getVariables();
+        for (std::string_view name : reader.row()) {
+            auto member = std::find_if(variables.begin(), variables.end(), [name](auto &var) { return var->name == name; });
+            if (member == variables.end())
+                throw Interpreter::RuntimeError(token, ctx, "'" + std::string(name) + "' is not a member of '" + *arr.type.name + "'");
+            members.push_back(member - variables.begin());
+        }
+        columns = members.size();
+    }
+
+    auto location = [&]() {
+        return " on line " + std::to_string(reader.getLine()) + " of '" + filename.value + "'";
+    };
+
+    size_t row = 0;
+    while (reader.next()) {
+        std::span<const std::string_view> fields = reader.row();
+        if (row >= rows)
+            throw Interpreter::RuntimeError(token, ctx, "Too many rows for '" + arr.name + "'" + location());
+        if (fields.size() != columns)
+            throw Interpreter::RuntimeError(token, ctx, "Expected " + std::to_string(columns) + " fields" + location());
+
+        for (size_t column = 0; column < columns; column++) {
+            Interpreter::Variable &var = composite
+                ? *arr.getElementAt(row).get<Interpreter::Composite>().ctx->getVariables()[members[column]]
+                : arr.getElementAt(row + column * rows);
+            if (!Interpreter::CsvReader::setValue(var, fields[column], ctx))
+                throw Interpreter::RuntimeError(token, ctx, "Invalid value '" + std::string(fields[column]) + "' for '" + var.name + "'" + location());
+        }
+        row++;
+    }
+
+    if (count != nullptr) count->get<Interpreter::Integer>().value = row;
+
+    return std::make_unique<NodeResult>(nullptr, Interpreter::DataType::NONE);
+}
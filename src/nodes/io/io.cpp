@@ -2,99 +2,98 @@
 #include <iostream>
 
 #include "interpreter/error.h"
+#include "interpreter/input.h"
 #include "nodes/io/io.h"
 
-OutputNode::OutputNode(const Token &token, std::vector<Node*> &&nodes)
-    : Node(token), nodes(std::move(nodes))
+OutputNode::OutputNode(const Token &token, std::span<Node *const> nodes)
+    : Node(token), nodes(nodes)
 {}
 
 std::unique_ptr<NodeResult> OutputNode::evaluate(Interpreter::Context &ctx) {
+    std::ostream &output = ctx.getInstance().getOutput();
     for (Node *node : nodes) {
         auto result = node->evaluate(ctx);
 
         switch (result->type.type) {
             case Interpreter::DataType::INTEGER:
-                std::cout << result->get<Interpreter::Integer>();
+                output << result->get<Interpreter::Integer>();
                 break;
             case Interpreter::DataType::REAL: {
-                Interpreter::real_t value = result->get<Interpreter::Real>();
-                std::cout << value;
-
-                double integerValue;
-                if (std::modf(value, &integerValue) == 0.0) std::cout << ".0";
+                char buffer[Interpreter::Real::formatSize];
+                output.write(buffer, Interpreter::Real::format(result->get<Interpreter::Real>(), buffer, true));
                 break;
             } case Interpreter::DataType::BOOLEAN:
-                std::cout << (result->get<Interpreter::Boolean>() ? "TRUE" : "FALSE");
+                output << (result->get<Interpreter::Boolean>() ? "TRUE" : "FALSE");
                 break;
             case Interpreter::DataType::CHAR:
-                std::cout << result->get<Interpreter::Char>();
+                output << result->get<Interpreter::Char>();
                 break;
             case Interpreter::DataType::STRING:
-                std::cout << result->get<Interpreter::String>().value;
+                output << result->get<Interpreter::String>().value;
                 break;
             case Interpreter::DataType::DATE: {
                 auto str = result->get<Interpreter::Date>().toString();
-                std::cout << str->value;
+                output << str->value;
                 break;
             } case Interpreter::DataType::ENUM:
-                std::cout << result->get<Interpreter::Enum>().getString(ctx);
+                output << result->get<Interpreter::Enum>().getString(ctx);
                 break;
             case Interpreter::DataType::POINTER:
-                std::cout << result->get<Interpreter::Pointer>().definitionName << " object";
+                output << result->get<Interpreter::Pointer>().definitionName << " object";
                 break;
             case Interpreter::DataType::COMPOSITE:
-                std::cout << result->get<Interpreter::Composite>().definitionName << " object";
+                output << result->get<Interpreter::Composite>().definitionName << " object";
                 break;
             case Interpreter::DataType::NONE:
-                std::cout.flush();
+                output.flush();
                 throw Interpreter::RuntimeError(node->getToken(), ctx, "Expected a value for OUTPUT/PRINT");
         }
     }
-    std::cout << std::endl;
+    output << '\n';
 
     return std::make_unique<NodeResult>(nullptr, Interpreter::DataType::NONE);
 }
 
 
-InputNode::InputNode(const Token &token, std::unique_ptr<AbstractVariableResolver> &&resolver)
-    : Node(token), resolver(std::move(resolver))
+InputNode::InputNode(const Token &token, const AbstractVariableResolver &resolver)
+    : Node(token), resolver(resolver)
 {}
 
 std::unique_ptr<NodeResult> InputNode::evaluate(Interpreter::Context &ctx) {
     Interpreter::Variable *var;
     try {
-        Interpreter::DataHolder &holder = resolver->resolve(ctx);
+        Interpreter::DataHolder &holder = resolver.resolve(ctx);
         if (holder.isArray())
             throw Interpreter::ArrayDirectAccessError(token, ctx);
 
         var = static_cast<Interpreter::Variable*>(&holder);
     } catch (Interpreter::NotDefinedError &e) {
-        const SimpleVariableSource *simpleSource = dynamic_cast<const SimpleVariableSource*>(resolver.get());
+        const SimpleVariableSource *simpleSource = dynamic_cast<const SimpleVariableSource*>(&resolver);
         if (simpleSource == nullptr) throw e;
         if (ctx.isIdentifierType(simpleSource->getToken())) throw e;
 
-        var = new Interpreter::Variable(simpleSource->getName(), Interpreter::DataType::STRING, false, &ctx);
+        var = new Interpreter::Variable(std::string(simpleSource->getName()), Interpreter::DataType::STRING, false, &ctx);
         ctx.addVariable(var);
     }
 
-    Interpreter::String inputStr;
-    std::getline(std::cin, inputStr.value);
+    std::string_view input;
+    ctx.getInstance().getInput().readLine(input);
 
     switch (var->type.type) {
         case Interpreter::DataType::INTEGER:
-            var->get<Interpreter::Integer>() = inputStr.toInteger()->value;
+            var->get<Interpreter::Integer>().value = Interpreter::String::parseInteger(input);
             break;
         case Interpreter::DataType::REAL:
-            var->get<Interpreter::Real>() = inputStr.toReal()->value;
+            var->get<Interpreter::Real>().value = Interpreter::String::parseReal(input);
             break;
         case Interpreter::DataType::BOOLEAN:
-            var->get<Interpreter::Boolean>() = (inputStr.value == "TRUE");
+            var->get<Interpreter::Boolean>() = (input == "TRUE");
             break;
         case Interpreter::DataType::CHAR:
-            var->get<Interpreter::Char>() = inputStr.value.front();
+            var->get<Interpreter::Char>() = input.empty() ? '\0' : input.front();
             break;
         case Interpreter::DataType::STRING:
-            var->get<Interpreter::String>().value = std::move(inputStr.value);
+            var->get<Interpreter::String>().value = input;
             break;
         case Interpreter::DataType::DATE:
         case Interpreter::DataType::ENUM:
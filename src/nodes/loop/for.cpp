@@ -1,29 +1,23 @@
 #include "pch.h"
+#include <limits>
 
 #include "interpreter/error.h"
 #include "nodes/loop/control.h"
 #include "nodes/loop/for.h"
+#include "nodes/functions/function.h"
+#include "interpreter/threadPool.h"
 
-ForLoopNode::ForLoopNode(const Token &token, const Token &identifier, Node &start, Node &stop, Node *step, Interpreter::Block *block)
+ForLoopNode::ForLoopNode(const Token &token, const Token &identifier, Node &start, Node &stop, Node *step, Interpreter::Block *block, bool localIterator)
     : Node(token),
     identifier(identifier),
     start(start),
     stop(stop),
     step(step),
-    block(block)
+    block(block),
+    localIterator(localIterator)
 {}
 
-std::unique_ptr<NodeResult> ForLoopNode::evaluate(Interpreter::Context &ctx) {
-    Interpreter::Variable *iterator = ctx.getVariable(identifier.value);
-    if (iterator == nullptr) {
-        iterator = new Interpreter::Variable(identifier.value, Interpreter::DataType::INTEGER, false, &ctx);
-        ctx.addVariable(iterator);
-    }
-
-    if (iterator->type != Interpreter::DataType::INTEGER)
-        throw Interpreter::RuntimeError(token, ctx, "Iterator variable must be of type INTEGER");
-
-
+void ForLoopNode::evaluateRange(Interpreter::Context &ctx, Interpreter::int_t &startValue, Interpreter::int_t &stopValue, Interpreter::int_t &stepValue) {
     auto startRes = start.evaluate(ctx);
 
     if (startRes->type != Interpreter::DataType::INTEGER)
@@ -36,7 +30,6 @@ std::unique_ptr<NodeResult> ForLoopNode::evaluate(Interpreter::Context &ctx) {
         throw Interpreter::RuntimeError(token, ctx, "Stop value of FOR loop iterator must be of type INTEGER");
 
 
-    Interpreter::int_t stepValue;
     if (step != nullptr) {
         auto stepRes = step->evaluate(ctx);
 
@@ -48,10 +41,24 @@ std::unique_ptr<NodeResult> ForLoopNode::evaluate(Interpreter::Context &ctx) {
         stepValue = 1;
     }
 
-    Interpreter::Integer &iteratorValue = iterator->get<Interpreter::Integer>();
+    startValue = startRes->get<Interpreter::Integer>();
+    stopValue = stopRes->get<Interpreter::Integer>();
+}
+
+std::unique_ptr<NodeResult> ForLoopNode::evaluate(Interpreter::Context &ctx) {
+    Interpreter::Variable *iterator = ctx.getVariable(identifier.value, !localIterator);
+    if (iterator == nullptr) {
+        iterator = new Interpreter::Variable(std::string(identifier.value), Interpreter::DataType::INTEGER, false, &ctx);
+        ctx.addVariable(iterator);
+    }
+
+    if (iterator->type != Interpreter::DataType::INTEGER)
+        throw Interpreter::RuntimeError(token, ctx, "Iterator variable must be of type INTEGER");
+
+    Interpreter::int_t startValue, stopValue, stepValue;
+    evaluateRange(ctx, startValue, stopValue, stepValue);
 
-    Interpreter::int_t startValue = startRes->get<Interpreter::Integer>();
-    Interpreter::int_t stopValue = stopRes->get<Interpreter::Integer>();
+    Interpreter::Integer &iteratorValue = iterator->get<Interpreter::Integer>();
 
     bool stepNegative = stepValue < 0;
 
@@ -70,3 +77,119 @@ std::unique_ptr<NodeResult> ForLoopNode::evaluate(Interpreter::Context &ctx) {
 
     return std::make_unique<NodeResult>(nullptr, Interpreter::DataType::NONE);
 }
+
+
+// REAL reductions are split into this many chunks whatever the number of threads, so their rounding never changes
+constexpr size_t reductionChunks = 256;
+
+ParallelForNode::ParallelForNode(const Token &token, const Token &identifier, Node &start, Node &stop, Node *step, Interpreter::Block *block,
+    std::span<FunctionCallNode *const> calls, std::span<const Reduction> reductions)
+    : ForLoopNode(token, identifier, start, stop, step, block), calls(calls), reductions(reductions)
+{}
+
+void ParallelForNode::runIteration(Interpreter::Context &ctx, Interpreter::int_t value, std::span<Interpreter::Variable *const> accumulators) {
+    auto frame = Interpreter::Context::createFrame(ctx, "PARALLEL FOR");
+    Interpreter::Integer iteratorValue(value);
+    frame->addVariable(new Interpreter::Variable(std::string(identifier.value), Interpreter::DataType::INTEGER, true, frame.get(), &iteratorValue));
+    for (Interpreter::Variable *accumulator : accumulators) frame->addVariable(accumulator->createReference(accumulator->name));
+
+    try {
+        block->run(*frame);
+    } catch (ContinueErrSignal&) {}
+}
+
+// Sets var to the value REDUCE starts each chunk from
+static void setIdentity(Interpreter::Variable &var, ParallelForNode::Reduction::Operation operation) {
+    using Operation = ParallelForNode::Reduction::Operation;
+    if (var.type == Interpreter::DataType::INTEGER) {
+        Interpreter::int_t &value = var.get<Interpreter::Integer>().value;
+        if (operation == Operation::MIN) value = std::numeric_limits<Interpreter::int_t>::max();
+        else if (operation == Operation::MAX) value = std::numeric_limits<Interpreter::int_t>::min();
+        else value = 0;
+    } else {
+        Interpreter::real_t &value = var.get<Interpreter::Real>().value;
+        if (operation == Operation::MIN) value = std::numeric_limits<Interpreter::real_t>::infinity();
+        else if (operation == Operation::MAX) value = -std::numeric_limits<Interpreter::real_t>::infinity();
+        else value = 0;
+    }
+}
+
+template<typename T>
+static void combine(T &total, T partial, ParallelForNode::Reduction::Operation operation) {
+    using Operation = ParallelForNode::Reduction::Operation;
+    if (operation == Operation::MIN) total = std::min(total, partial);
+    else if (operation == Operation::MAX) total = std::max(total, partial);
+    else total += partial;
+}
+
+std::unique_ptr<NodeResult> ParallelForNode::evaluate(Interpreter::Context &ctx) {
+    Interpreter::int_t startValue, stopValue, stepValue;
+    evaluateRange(ctx, startValue, stopValue, stepValue);
+    if (stepValue == 0)
+        throw Interpreter::RuntimeError(token, ctx, "Step value of PARALLEL FOR loop cannot be 0");
+
+    std::vector<Interpreter::Variable*> targets;
+    for (const Reduction &reduction : reductions) {
+        Interpreter::Variable *target = ctx.getVariable(reduction.variable->value);
+        if (target == nullptr)
+            throw Interpreter::NotDefinedError(*reduction.variable, ctx, "Variable '" + std::string(reduction.variable->value) + "'");
+        if (target->isConstant)
+            throw Interpreter::ConstAssignError(*reduction.variable, ctx, target->name);
+        if (reduction.operation == Reduction::Operation::COUNT && target->type != Interpreter::DataType::INTEGER)
+            throw Interpreter::RuntimeError(*reduction.variable, ctx, "COUNT variable '" + target->name + "' must be of type INTEGER");
+        if (target->type != Interpreter::DataType::INTEGER && target->type != Interpreter::DataType::REAL)
+            throw Interpreter::RuntimeError(*reduction.variable, ctx, "REDUCE variable '" + target->name + "' must be of type INTEGER or REAL");
+        targets.push_back(target);
+    }
+
+    Interpreter::int_t count = 0;
+    if (stepValue > 0 && startValue <= stopValue) count = (stopValue - startValue) / stepValue + 1;
+    if (stepValue < 0 && startValue >= stopValue) count = (startValue - stopValue) / -stepValue + 1;
+
+    // Errors inside the body show the loop in their traceback
+    ctx.switchToken = &token;
+
+    Interpreter::ThreadPool &pool = Interpreter::ThreadPool::shared();
+    bool parallel = pool.concurrency() > 1 && count > 1;
+    for (FunctionCallNode *call : calls) {
+        Interpreter::Function *function = ctx.getFunction(call->getToken().value);
+        if (function != nullptr && function->block != nullptr) parallel = false;
+    }
+
+    // Several chunks per thread, handed out as threads become free, so uneven iterations still balance.
+    // Reductions keep the same chunks even when run on one thread, so they always add up in the same order.
+    size_t chunks = reductions.empty() ? std::min<size_t>(count, parallel ? pool.concurrency() * 8 : 1) : std::min<size_t>(count, reductionChunks);
+    std::vector<std::unique_ptr<Interpreter::Variable>> partials(chunks * targets.size());
+
+    auto runChunk = [&](size_t chunk) {
+        std::vector<Interpreter::Variable*> accumulators;
+        for (size_t r = 0; r < targets.size(); r++) {
+            auto &partial = partials[chunk * targets.size() + r];
+            partial = std::make_unique<Interpreter::Variable>(targets[r]->name, targets[r]->type, false, &ctx);
+            setIdentity(*partial, reductions[r].operation);
+            accumulators.push_back(partial.get());
+        }
+
+        // The first count % chunks chunks take one extra iteration, worked out without multiplying count so huge ranges can't overflow
+        Interpreter::int_t size = count / chunks, extra = count % chunks;
+        Interpreter::int_t first = chunk * size + std::min<Interpreter::int_t>(chunk, extra);
+        Interpreter::int_t last = first + size + (static_cast<Interpreter::int_t>(chunk) < extra ? 1 : 0);
+        for (Interpreter::int_t i = first; i < last; i++) runIteration(ctx, startValue + i * stepValue, accumulators);
+    };
+
+    if (parallel) pool.run(chunks, runChunk);
+    else for (size_t chunk = 0; chunk < chunks; chunk++) runChunk(chunk);
+
+    // Combined in chunk order, whichever threads finished first
+    for (size_t r = 0; r < targets.size(); r++) {
+        for (size_t chunk = 0; chunk < chunks; chunk++) {
+            Interpreter::Variable &partial = *partials[chunk * targets.size() + r];
+            if (targets[r]->type == Interpreter::DataType::INTEGER)
+                combine(targets[r]->get<Interpreter::Integer>().value, partial.get<Interpreter::Integer>().value, reductions[r].operation);
+            else
+                combine(targets[r]->get<Interpreter::Real>().value, partial.get<Interpreter::Real>().value, reductions[r].operation);
+        }
+    }
+
+    return std::make_unique<NodeResult>(nullptr, Interpreter::DataType::NONE);
+}
@@ -3,12 +3,14 @@
 #include "interpreter/error.h"
 #include "nodes/variable/variable.h"
 #include "nodes/variable/array.h"
+#include "interpreter/record.h"
 
-ArrayDeclareNode::ArrayDeclareNode(const Token &token, std::vector<const Token*> &&identifiers, const Token &type, std::vector<Node*> &&bounds)
+ArrayDeclareNode::ArrayDeclareNode(const Token &token, std::vector<const Token*> &&identifiers, const Token &type, std::span<Node *const> bounds, Node *persistent)
     : Node(token),
     identifiers(identifiers),
     type(type),
-    bounds(std::move(bounds))
+    bounds(bounds),
+    persistent(persistent)
 {}
 
 std::unique_ptr<NodeResult> ArrayDeclareNode::evaluate(Interpreter::Context &ctx) {
@@ -16,7 +18,7 @@ std::unique_ptr<NodeResult> ArrayDeclareNode::evaluate(Interpreter::Context &ctx
 
     for (auto identifier : identifiers) {
         if (ctx.getArray(identifier->value, false) != nullptr)
-            throw Interpreter::RedeclarationError(token, ctx, identifier->value);
+            throw Interpreter::RedeclarationError(token, ctx, std::string(identifier->value));
     }
 
     std::vector<Interpreter::ArrayDimension> dimensions;
@@ -42,12 +44,44 @@ std::unique_ptr<NodeResult> ArrayDeclareNode::evaluate(Interpreter::Context &ctx
     for (auto identifier : identifiers) {
         Interpreter::DataType dataType = ctx.getType(type);
         if (dataType.type == Interpreter::DataType::NONE)
-            throw Interpreter::NotDefinedError(token, ctx, "Type '" + type.value + "'");
+            throw Interpreter::NotDefinedError(token, ctx, "Type '" + std::string(type.value) + "'");
 
-        auto array = std::make_unique<Interpreter::Array>(identifier->value, dataType, dimensions);
+        auto array = std::make_unique<Interpreter::Array>(std::string(identifier->value), dataType, dimensions);
         array->init(ctx);
+        if (persistent != nullptr) persist(*array, ctx);
         ctx.addArray(std::move(array));
     }
 
     return std::make_unique<NodeResult>(nullptr, Interpreter::DataType::NONE);
 }
+
+void ArrayDeclareNode::persist(Interpreter::Array &array, Interpreter::Context &ctx) {
+    auto filenameRes = persistent->evaluate(ctx);
+    if (filenameRes->type != Interpreter::DataType::STRING)
+        throw Interpreter::RuntimeError(persistent->getToken(), ctx, "Expected string for file name");
+    const std::string &filename = filenameRes->get<Interpreter::String>().value;
+
+    // Only fixed width values, strings could be cut short when written back
+    switch (array.type.type) {
+        case Interpreter::DataType::INTEGER:
+        case Interpreter::DataType::REAL:
+        case Interpreter::DataType::BOOLEAN:
+        case Interpreter::DataType::CHAR:
+        case Interpreter::DataType::DATE:
+        case Interpreter::DataType::ENUM:
+            break;
+        default:
+            throw Interpreter::RuntimeError(token, ctx, "PERSISTENT arrays must be of type INTEGER, REAL, BOOLEAN, CHAR, DATE or an enum");
+    }
+
+    size_t size = Interpreter::Record::size(array.getElementAt(0)) * array.getSize();
+    auto file = std::make_unique<Interpreter::ArrayFile>();
+    Interpreter::ArrayFile::Status status = file->open(filename, size);
+    if (status == Interpreter::ArrayFile::Status::FAILED)
+        throw Interpreter::RuntimeError(token, ctx, "Failed to open file '" + filename + "'");
+    if (status == Interpreter::ArrayFile::Status::WRONG_SIZE)
+        throw Interpreter::RuntimeError(token, ctx, "Size of file '" + filename + "' does not match array '" + array.name + "'");
+
+    if (!array.persist(std::move(file), status == Interpreter::ArrayFile::Status::OPENED, ctx))
+        throw Interpreter::RuntimeError(token, ctx, "File '" + filename + "' does not hold valid elements for array '" + array.name + "'");
+}
@@ -9,9 +9,9 @@ CompositeDefineNode::CompositeDefineNode(const Token &token, const Token &name,
 
 std::unique_ptr<NodeResult> CompositeDefineNode::evaluate(Interpreter::Context &ctx) {
     if (ctx.isIdentifierType(name, false))
-        throw Interpreter::RedefinitionError(token, ctx, name.value);
+        throw Interpreter::RedefinitionError(token, ctx, std::string(name.value));
     
-    Interpreter::CompositeTypeDefinition definition(name.value, initBlock);
+    Interpreter::CompositeTypeDefinition definition(std::string(name.value), initBlock);
     ctx.createCompositeDefinition(std::move(definition));
     return std::make_unique<NodeResult>(nullptr, Interpreter::DataType::NONE);
 }
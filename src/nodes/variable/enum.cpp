@@ -9,9 +9,9 @@ EnumDefineNode::EnumDefineNode(const Token &token, const Token &name, std::vecto
 
 std::unique_ptr<NodeResult> EnumDefineNode::evaluate(Interpreter::Context &ctx) {
     if (ctx.isIdentifierType(name, false))
-        throw Interpreter::RedefinitionError(token, ctx, name.value);
+        throw Interpreter::RedefinitionError(token, ctx, std::string(name.value));
 
-    Interpreter::EnumTypeDefinition definition(name.value, std::move(values));
+    Interpreter::EnumTypeDefinition definition(std::string(name.value), std::move(values));
     ctx.createEnumDefinition(std::move(definition));
     return std::make_unique<NodeResult>(nullptr, Interpreter::DataType::NONE);
 }
@@ -10,31 +10,31 @@ PointerDefineNode::PointerDefineNode(const Token &token, const Token &name, cons
 std::unique_ptr<NodeResult> PointerDefineNode::evaluate(Interpreter::Context &ctx) {
     Interpreter::DataType pointerType = ctx.getType(type);
     if (pointerType == Interpreter::DataType::NONE)
-        throw Interpreter::NotDefinedError(token, ctx, "Type '" + type.value + "'");
+        throw Interpreter::NotDefinedError(token, ctx, "Type '" + std::string(type.value) + "'");
 
     if (ctx.isIdentifierType(name, false))
-        throw Interpreter::RedefinitionError(token, ctx, name.value);
+        throw Interpreter::RedefinitionError(token, ctx, std::string(name.value));
 
-    Interpreter::PointerTypeDefinition definition(name.value, pointerType);
+    Interpreter::PointerTypeDefinition definition(std::string(name.value), pointerType);
     ctx.createPointerDefinition(std::move(definition));
     return std::make_unique<NodeResult>(nullptr, Interpreter::DataType::NONE);
 }
 
 PointerAssignNode::PointerAssignNode(
     const Token &token,
-    std::unique_ptr<AbstractVariableResolver> &&pointerResolver,
-    std::unique_ptr<AbstractVariableResolver> &&valueResolver
+    const AbstractVariableResolver &pointerResolver,
+    const AbstractVariableResolver &valueResolver
 ) : Node(token),
-    pointerResolver(std::move(pointerResolver)),
-    valueResolver(std::move(valueResolver))
+    pointerResolver(pointerResolver),
+    valueResolver(valueResolver)
 {}
 
 std::unique_ptr<NodeResult> PointerAssignNode::evaluate(Interpreter::Context &ctx) {
-    auto &pointerHolder = pointerResolver->resolve(ctx);
+    auto &pointerHolder = pointerResolver.resolve(ctx);
     if (pointerHolder.isArray())
         throw Interpreter::ArrayDirectAccessError(token, ctx);
 
-    auto &valueHolder = valueResolver->resolve(ctx);
+    auto &valueHolder = valueResolver.resolve(ctx);
     if (valueHolder.isArray())
         throw Interpreter::RuntimeError(token, ctx, "Cannot store pointer to array");
     
@@ -7,11 +7,11 @@
 AbstractVariableResolver::AbstractVariableResolver(const Token &token)
     : token(token) {}
 
-PointerDereferencer::PointerDereferencer(const Token &token, std::unique_ptr<AbstractVariableResolver> &&resolver)
-    : AbstractVariableResolver(token), resolver(std::move(resolver)) {}
+PointerDereferencer::PointerDereferencer(const Token &token, const AbstractVariableResolver &resolver)
+    : AbstractVariableResolver(token), resolver(resolver) {}
 
 Interpreter::DataHolder &PointerDereferencer::resolve(Interpreter::Context &ctx) const {
-    auto &dh = resolver->resolve(ctx);
+    auto &dh = resolver.resolve(ctx);
     if (dh.isArray())
         throw Interpreter::InvalidUsageError(token, ctx, "'^' operator: Attempting to dereference non-pointer");
 
@@ -35,14 +35,18 @@ Interpreter::DataHolder &PointerDereferencer::resolve(Interpreter::Context &ctx)
     return *ptrVar;
 }
 
-CompositeResolver::CompositeResolver(const Token &token, std::unique_ptr<AbstractVariableResolver> &&resolver, const Token &member)
+const AbstractVariableResolver &PointerDereferencer::getResolver() const {
+    return resolver;
+}
+
+CompositeResolver::CompositeResolver(const Token &token, const AbstractVariableResolver &resolver, const Token &member)
     : AbstractVariableResolver(token),
-    resolver(std::move(resolver)),
+    resolver(resolver),
     member(member)
 {}
 
 Interpreter::DataHolder &CompositeResolver::resolve(Interpreter::Context &ctx) const {
-    auto &dh = resolver->resolve(ctx);
+    auto &dh = resolver.resolve(ctx);
     if (dh.isArray())
         throw Interpreter::InvalidUsageError(token, ctx, "'.' operator: Variable is not a composite type");
 
@@ -53,19 +57,27 @@ Interpreter::DataHolder &CompositeResolver::resolve(Interpreter::Context &ctx) c
     auto &composite = var.get<Interpreter::Composite>();
     auto *memberPtr = composite.getMember(member.value);
     if (memberPtr == nullptr)
-        throw Interpreter::RuntimeError(token, ctx, "Type '" + composite.definitionName + "' has no member '" + member.value + "'");
+        throw Interpreter::RuntimeError(token, ctx, "Type '" + composite.definitionName + "' has no member '" + std::string(member.value) + "'");
     
     return *memberPtr;
 }
 
-ArrayElementResolver::ArrayElementResolver(const Token &token, std::unique_ptr<AbstractVariableResolver> &&resolver, std::vector<Node*> &&indices)
+const AbstractVariableResolver &CompositeResolver::getResolver() const {
+    return resolver;
+}
+
+const Token &CompositeResolver::getMember() const {
+    return member;
+}
+
+ArrayElementResolver::ArrayElementResolver(const Token &token, const AbstractVariableResolver &resolver, std::span<Node *const> indices)
     : AbstractVariableResolver(token),
-    indices(std::move(indices)),
-    resolver(std::move(resolver))
+    indices(indices),
+    resolver(resolver)
 {}
 
 Interpreter::DataHolder &ArrayElementResolver::resolve(Interpreter::Context &ctx) const {
-    auto &dh = resolver->resolve(ctx);
+    auto &dh = resolver.resolve(ctx);
     if (!dh.isArray())
         throw Interpreter::RuntimeError(token, ctx, "Attempting to index non-array variable '" + dh.name + "'");
 
@@ -95,6 +107,14 @@ Interpreter::DataHolder &ArrayElementResolver::resolve(Interpreter::Context &ctx
     return var;
 }
 
+const AbstractVariableResolver &ArrayElementResolver::getResolver() const {
+    return resolver;
+}
+
+std::span<Node *const> ArrayElementResolver::getIndices() const {
+    return indices;
+}
+
 Interpreter::DataHolder &SimpleVariableSource::resolve(Interpreter::Context &ctx) const {
     Interpreter::Variable *var = ctx.getVariable(token.value);
     if (var != nullptr) return *var;
@@ -103,10 +123,10 @@ Interpreter::DataHolder &SimpleVariableSource::resolve(Interpreter::Context &ctx
     if (arr != nullptr)
         return *arr;
 
-    throw Interpreter::NotDefinedError(token, ctx, "Identifier '" + token.value + "'");
+    throw Interpreter::NotDefinedError(token, ctx, "Identifier '" + std::string(token.value) + "'");
 }
 
-const std::string &SimpleVariableSource::getName() const {
+std::string_view SimpleVariableSource::getName() const {
     return token.value;
 }
 
@@ -10,16 +10,16 @@ DeclareNode::DeclareNode(const Token &token, std::vector<const Token*> &&identif
 std::unique_ptr<NodeResult> DeclareNode::evaluate(Interpreter::Context &ctx) {
     for (auto identifier : identifiers) {
         if (ctx.getVariable(identifier->value, false) != nullptr)
-            throw Interpreter::RedeclarationError(token, ctx, identifier->value);
+            throw Interpreter::RedeclarationError(token, ctx, std::string(identifier->value));
 
         if (ctx.isIdentifierType(*identifier))
-            throw Interpreter::RuntimeError(token, ctx, "Redefinition of type '" + identifier->value + "' as variable");
+            throw Interpreter::RuntimeError(token, ctx, "Redefinition of type '" + std::string(identifier->value) + "' as variable");
 
         Interpreter::DataType dataType = ctx.getType(type);
         if (dataType == Interpreter::DataType::NONE)
-            throw Interpreter::NotDefinedError(token, ctx, "Type '" + type.value + "'");
+            throw Interpreter::NotDefinedError(token, ctx, "Type '" + std::string(type.value) + "'");
 
-        ctx.addVariable(new Interpreter::Variable(identifier->value, dataType, false, &ctx));
+        ctx.addVariable(new Interpreter::Variable(std::string(identifier->value), dataType, false, &ctx));
     }
 
     return std::make_unique<NodeResult>(nullptr, Interpreter::DataType::NONE);
@@ -34,24 +34,24 @@ std::unique_ptr<NodeResult> ConstDeclareNode::evaluate(Interpreter::Context &ctx
     auto value = node.evaluate(ctx);
 
     if (ctx.getVariable(identifier.value, false) != nullptr)
-        throw Interpreter::RedeclarationError(token, ctx, identifier.value);
+        throw Interpreter::RedeclarationError(token, ctx, std::string(identifier.value));
 
-    ctx.addVariable(new Interpreter::Variable(identifier.value, value->type, true, &ctx, value->data.get()));
+    ctx.addVariable(new Interpreter::Variable(std::string(identifier.value), value->type, true, &ctx, value->data.get()));
 
     return std::make_unique<NodeResult>(nullptr, Interpreter::DataType::NONE);
 }
 
 
-AssignNode::AssignNode(const Token &token, Node &node, std::unique_ptr<AbstractVariableResolver> &&resolver)
-    : UnaryNode(token, node), resolver(std::move(resolver))
+AssignNode::AssignNode(const Token &token, Node &node, const AbstractVariableResolver &resolver)
+    : UnaryNode(token, node), resolver(resolver)
 {}
 
 void AssignNode::assignArray(Interpreter::Context &ctx, const Interpreter::ArrayDirectAccessError &e) {
     AccessNode *accsNode = dynamic_cast<AccessNode*>(&node);
     if (accsNode == nullptr) throw e;
-    auto array = static_cast<Interpreter::Array*>(&accsNode->resolver->resolve(ctx));
+    auto array = static_cast<Interpreter::Array*>(&accsNode->resolver.resolve(ctx));
     
-    Interpreter::DataHolder &holder = resolver->resolve(ctx);
+    Interpreter::DataHolder &holder = resolver.resolve(ctx);
     if (!holder.isArray()) throw e;
     
     Interpreter::Array *arr = static_cast<Interpreter::Array*>(&holder);
@@ -75,17 +75,17 @@ std::unique_ptr<NodeResult> AssignNode::evaluate(Interpreter::Context &ctx) {
 
     Interpreter::Variable *var;
     try {
-        Interpreter::DataHolder &holder = resolver->resolve(ctx);
+        Interpreter::DataHolder &holder = resolver.resolve(ctx);
         if (holder.isArray())
             throw Interpreter::ArrayDirectAccessError(token, ctx);
 
         var = static_cast<Interpreter::Variable*>(&holder);
     } catch (Interpreter::NotDefinedError &e) {
-        const SimpleVariableSource *simpleSource = dynamic_cast<const SimpleVariableSource*>(resolver.get());
+        const SimpleVariableSource *simpleSource = dynamic_cast<const SimpleVariableSource*>(&resolver);
         if (simpleSource == nullptr) throw e;
         if (ctx.isIdentifierType(simpleSource->getToken())) throw e;
 
-        var = new Interpreter::Variable(simpleSource->getName(), valueRes->type, false, &ctx);
+        var = new Interpreter::Variable(std::string(simpleSource->getName()), valueRes->type, false, &ctx);
         ctx.addVariable(var);
     }
 
@@ -132,13 +132,13 @@ std::unique_ptr<NodeResult> AssignNode::evaluate(Interpreter::Context &ctx) {
 }
 
 
-AccessNode::AccessNode(const Token &token, std::unique_ptr<AbstractVariableResolver> &&resolver)
-    : Node(token), resolver(std::move(resolver)) {}
+AccessNode::AccessNode(const Token &token, const AbstractVariableResolver &resolver)
+    : Node(token), resolver(resolver) {}
 
 std::unique_ptr<NodeResult> AccessNode::evaluate(Interpreter::Context &ctx) {
     Interpreter::DataHolder *holder;
     try {
-        holder = &resolver->resolve(ctx);
+        holder = &resolver.resolve(ctx);
     } catch (Interpreter::NotDefinedError &e) {
         auto def = ctx.getEnumElement(token.value);
         if (def != nullptr)
@@ -188,5 +188,5 @@ std::unique_ptr<NodeResult> AccessNode::evaluate(Interpreter::Context &ctx) {
 }
 
 const AbstractVariableResolver &AccessNode::getResolver() const {
-    return *resolver;
+    return resolver;
 }
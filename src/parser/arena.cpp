@@ -0,0 +1,23 @@
+#include "pch.h"
+#include <algorithm>
+
+#include "parser/arena.h"
+
+void Arena::addChunk(size_t minSize) {
+    size_t size = std::max(nextChunkSize, minSize);
+    if (nextChunkSize < 1024 * 1024) nextChunkSize *= 2;
+
+    Chunk &chunk = chunks.emplace_back(Chunk{std::unique_ptr<std::byte[]>(new std::byte[size]), size});
+    current = chunk.data.get();
+    end = current + size;
+}
+
+void Arena::reserve(size_t bytes) {
+    if (current == nullptr || static_cast<size_t>(end - current) < bytes) addChunk(bytes);
+}
+
+Arena::~Arena() {
+    for (auto it = destructors.rbegin(); it != destructors.rend(); it++) {
+        it->destroy(it->object);
+    }
+}
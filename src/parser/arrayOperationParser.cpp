@@ -42,5 +42,15 @@ Node *Parser::parseArrayDeclare(const Token &declareToken, std::vector<const Tok
     const Token &type = *currentToken;
     advance();
 
-    return create<ArrayDeclareNode>(declareToken, std::move(identifiers), type, std::move(bounds));
+    Node *persistent = nullptr;
+    if (currentToken->type == TokenType::PERSISTENT) {
+        if (parallelBody != nullptr)
+            throw Interpreter::SyntaxError(*currentToken, "PERSISTENT arrays cannot be declared in a PARALLEL FOR loop");
+        if (identifiers.size() > 1)
+            throw Interpreter::SyntaxError(*currentToken, "Only one array can be declared PERSISTENT at a time");
+        advance();
+        persistent = parseStringExpression();
+    }
+
+    return create<ArrayDeclareNode>(declareToken, std::move(identifiers), type, arena.copy(bounds), persistent);
 }
@@ -1,126 +1,107 @@
 #include "pch.h"
+#include <array>
 
 #include "parser/parser.h"
 
-Node *Parser::parseEvaluationExpression() {
-    Node *logicalExpression = parseLogicalExpression();
+// Precedence of every binary operator, indexed by token type. All other tokens have Precedence::NONE
+Parser::Precedence Parser::getPrecedence(TokenType type) {
+    static constexpr auto precedences = []() {
+        using enum TokenType;
+        std::array<Precedence, static_cast<size_t>(NOT) + 1> table{};
 
-    while (currentToken->type == TokenType::EQUALS || currentToken->type == TokenType::NOT_EQUALS) {
-        const Token &op = *currentToken;
-        advance();
-
-        Node *otherlogicalExpression = parseLogicalExpression();
-        logicalExpression = create<ComparisonNode>(op, *logicalExpression, *otherlogicalExpression);
-    }
+        table[static_cast<size_t>(AND)] = Precedence::LOGICAL;
+        table[static_cast<size_t>(OR)] = Precedence::LOGICAL;
 
-    return logicalExpression;
-}
+        table[static_cast<size_t>(EQUALS)] = Precedence::COMPARISON;
+        table[static_cast<size_t>(NOT_EQUALS)] = Precedence::COMPARISON;
+        table[static_cast<size_t>(GREATER)] = Precedence::COMPARISON;
+        table[static_cast<size_t>(LESSER)] = Precedence::COMPARISON;
+        table[static_cast<size_t>(GREATER_EQUAL)] = Precedence::COMPARISON;
+        table[static_cast<size_t>(LESSER_EQUAL)] = Precedence::COMPARISON;
 
-Node *Parser::parseLogicalExpression() {
-    Node *comparisonExpr = parseComparisonExpression();
+        table[static_cast<size_t>(AMPERSAND)] = Precedence::CONCATENATION;
 
-    while (currentToken->type == TokenType::AND || currentToken->type == TokenType::OR) {
-        const Token &op = *currentToken;
-        advance();
+        table[static_cast<size_t>(PLUS)] = Precedence::ADDITIVE;
+        table[static_cast<size_t>(MINUS)] = Precedence::ADDITIVE;
 
-        Node *otherComparisonExpr = parseComparisonExpression();
+        table[static_cast<size_t>(STAR)] = Precedence::MULTIPLICATIVE;
+        table[static_cast<size_t>(SLASH)] = Precedence::MULTIPLICATIVE;
+        table[static_cast<size_t>(DIV)] = Precedence::MULTIPLICATIVE;
+        table[static_cast<size_t>(MOD)] = Precedence::MULTIPLICATIVE;
 
-        comparisonExpr = create<LogicNode>(op, *comparisonExpr, *otherComparisonExpr);
-    }
+        return table;
+    }();
 
-    return comparisonExpr;
+    size_t idx = static_cast<size_t>(type);
+    return idx < precedences.size() ? precedences[idx] : Precedence::NONE;
 }
 
-Node *Parser::parseComparisonExpression() {
-    if (currentToken->type == TokenType::NOT) {
-        const Token &op = *currentToken;
-        advance();
-
-        Node *node = parseComparisonExpression();
-
-        return create<NotNode>(op, *node);
-    }
-
-    Node *strExpr = parseStringExpression();
-
-    while (
-        currentToken->type == TokenType::EQUALS
-        || currentToken->type == TokenType::NOT_EQUALS
-        || currentToken->type == TokenType::GREATER
-        || currentToken->type == TokenType::LESSER
-        || currentToken->type == TokenType::GREATER_EQUAL
-        || currentToken->type == TokenType::LESSER_EQUAL
-    ) {
-        const Token &op = *currentToken;
-        advance();
-
-        Node *otherStrExpr = parseStringExpression();
-
-        strExpr = create<ComparisonNode>(op, *strExpr, *otherStrExpr);
-    }
-
-    return strExpr;
+Node *Parser::parseEvaluationExpression() {
+    return parseBinaryExpression(Precedence::LOGICAL);
 }
 
 Node *Parser::parseStringExpression() {
-    Node *arithmeticExpr = parseArithmeticExpression();
-
-    while (currentToken->type == TokenType::AMPERSAND) {
-        const Token &op = *currentToken;
-        advance();
-
-        Node *otherArithmeticExpr = parseArithmeticExpression();
-
-        arithmeticExpr = create<StringConcatenationNode>(op, *arithmeticExpr, *otherArithmeticExpr);
-    }
-
-    return arithmeticExpr;
+    return parseBinaryExpression(Precedence::CONCATENATION);
 }
 
 Node *Parser::parseArithmeticExpression() {
-    Node *term = parseTerm();
+    return parseBinaryExpression(Precedence::ADDITIVE);
+}
 
-    while (currentToken->type == TokenType::PLUS || currentToken->type == TokenType::MINUS) {
+// Parses operators of minPrecedence or tighter in a single loop, recursing only for
+// right hand operands so every operator is left associative
+Node *Parser::parseBinaryExpression(Precedence minPrecedence) {
+    Node *left;
+    if (currentToken->type == TokenType::NOT && minPrecedence <= Precedence::COMPARISON) {
+        // NOT applies to a whole comparison, e.g. NOT a = b is NOT (a = b)
         const Token &op = *currentToken;
         advance();
 
-        Node *otherTerm = parseTerm();
-
-        term = create<ArithmeticOperationNode>(op, *term, *otherTerm);
+        Node *node = parseBinaryExpression(Precedence::COMPARISON);
+        left = create<NotNode>(op, *node);
+    } else {
+        left = parseUnary();
     }
 
-    return term;
-}
+    while (true) {
+        Precedence precedence = getPrecedence(currentToken->type);
+        if (precedence == Precedence::NONE || precedence < minPrecedence) break;
 
-Node *Parser::parseTerm() {
-    Node *factor = parseFactor();
-
-    while (
-        currentToken->type == TokenType::STAR
-        || currentToken->type == TokenType::SLASH
-        || currentToken->type == TokenType::DIV
-        || currentToken->type == TokenType::MOD
-    ) {
         const Token &op = *currentToken;
         advance();
 
-        Node *otherFactor = parseFactor();
-
-        factor = create<ArithmeticOperationNode>(op, *factor, *otherFactor);
+        Node *right = parseBinaryExpression(static_cast<Precedence>(static_cast<int>(precedence) + 1));
+        left = createBinaryNode(precedence, op, *left, *right);
     }
 
-    return factor;
+    return left;
 }
 
-Node *Parser::parseFactor() {
+Node *Parser::createBinaryNode(Precedence precedence, const Token &op, Node &left, Node &right) {
+    switch (precedence) {
+        case Precedence::LOGICAL:
+            return create<LogicNode>(op, left, right);
+        case Precedence::COMPARISON:
+            return create<ComparisonNode>(op, left, right);
+        case Precedence::CONCATENATION:
+            return create<StringConcatenationNode>(op, left, right);
+        case Precedence::ADDITIVE:
+        case Precedence::MULTIPLICATIVE:
+            return create<ArithmeticOperationNode>(op, left, right);
+        case Precedence::NONE:
+            break;
+    }
+    std::abort();
+}
+
+Node *Parser::parseUnary() {
+    // Unary minus only applies to the atom that follows it
     if (currentToken->type == TokenType::MINUS) {
         const Token &op = *currentToken;
         advance();
 
         Node *atom = parseAtom();
-        atom = create<NegateNode>(op, *atom);
-
-        return atom;
+        return create<NegateNode>(op, *atom);
     }
 
     return parseAtom();
@@ -143,6 +124,7 @@ Node *Parser::parseAtom() {
         if (compareNextType(1, TokenType::LPAREN)) return parseFunctionCall();
         
         const Token &identifier = *currentToken;
+        size_t reducedUses = parallelBody != nullptr ? parallelBody->reducedUses.size() : 0;
         auto resolver = parseIdentifierExpression();
         if (currentToken->type == TokenType::ASSIGNMENT) {
             const Token &token = *currentToken;
@@ -154,15 +136,28 @@ Node *Parser::parseAtom() {
 
                 if (currentToken->type != TokenType::IDENTIFIER)
                     throw Interpreter::ExpectedTokenError(*currentToken, "identifier");
+                const Token &valueToken = *currentToken;
                 auto valueResolver = parseIdentifierExpression();
 
-                return create<PointerAssignNode>(refToken, std::move(resolver), std::move(valueResolver));
+                if (parallelBody != nullptr) {
+                    addParallelRead(valueToken, *valueResolver);
+                    checkParallelAssignment(token, *resolver);
+                }
+                return create<PointerAssignNode>(refToken, *resolver, *valueResolver);
             } else {
+                const Token *valueStart = currentToken;
                 Node *expr = parseEvaluationExpression();
-                return create<AssignNode>(token, *expr, std::move(resolver));
+                if (parallelBody != nullptr) {
+                    auto *source = dynamic_cast<const SimpleVariableSource*>(resolver);
+                    const ParallelForNode::Reduction *reduction = source != nullptr ? findReduction(source->getName()) : nullptr;
+                    if (reduction != nullptr) checkReducedAssignment(token, *reduction, *expr, {valueStart, currentToken}, reducedUses);
+                    else checkParallelAssignment(token, *resolver);
+                }
+                return create<AssignNode>(token, *expr, *resolver);
             }
         } else {
-            return create<AccessNode>(identifier, std::move(resolver));
+            if (parallelBody != nullptr) addParallelRead(identifier, *resolver);
+            return create<AccessNode>(identifier, *resolver);
         }
 
         /*
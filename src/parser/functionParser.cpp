@@ -8,7 +8,7 @@ Node *Parser::parseFunction() {
 
     if (currentToken->type != TokenType::IDENTIFIER)
         throw Interpreter::ExpectedTokenError(*currentToken, "identifier");
-    const std::string &functionName = currentToken->value;
+    std::string_view functionName = currentToken->value;
     advance();
 
     bool byRef = false;
@@ -49,7 +49,7 @@ Node *Parser::parseFunction() {
 
             if (currentToken->type != TokenType::IDENTIFIER)
                 throw Interpreter::ExpectedTokenError(*currentToken, "identifier or ')'");
-            const std::string &paramName = currentToken->value;
+            std::string_view paramName = currentToken->value;
             advance();
 
             if (currentToken->type == TokenType::COLON) advance();
@@ -91,10 +91,7 @@ Node *Parser::parseFunction() {
     returnType = currentToken;
     advance();
 
-    Interpreter::Block *block = parseBlock();
-    if (currentToken->type != TokenType::ENDFUNCTION)
-        throw Interpreter::ExpectedTokenError(*currentToken, "'ENDFUNCTION'");
-    advance();
+    Interpreter::Block *block = skipRoutineBody(TokenType::ENDFUNCTION, "'ENDFUNCTION'");
 
     return create<FunctionNode>(
         functionToken,
@@ -130,5 +127,11 @@ Node *Parser::parseFunctionCall() {
         advance();
     }
 
-    return create<FunctionCallNode>(functionToken, std::move(args));
+    FunctionCallNode *call = create<FunctionCallNode>(functionToken, arena.copy(args));
+    if (parallelBody != nullptr) {
+        if (functionToken.value == "EOF")
+            throw Interpreter::SyntaxError(functionToken, "Input and output are not allowed in a PARALLEL FOR loop");
+        parallelBody->calls.push_back(call);
+    }
+    return call;
 }
@@ -14,7 +14,7 @@ Node *Parser::parseOutput() {
         nodes.push_back(parseEvaluationExpression());
     }
 
-    return create<OutputNode>(outputToken, std::move(nodes));
+    return create<OutputNode>(outputToken, arena.copy(nodes));
 }
 
 Node *Parser::parseInput() {
@@ -25,7 +25,7 @@ Node *Parser::parseInput() {
         throw Interpreter::ExpectedTokenError(*currentToken, "variable");
     auto resolver = parseIdentifierExpression();
 
-    return create<InputNode>(inputToken, std::move(resolver));
+    return create<InputNode>(inputToken, *resolver);
 }
 
 Node *Parser::parseOpenFile() {
@@ -49,8 +49,11 @@ Node *Parser::parseOpenFile() {
         case TokenType::APPEND:
             mode = Interpreter::FileMode::APPEND;
             break;
+        case TokenType::RANDOM:
+            mode = Interpreter::FileMode::RANDOM;
+            break;
         default:
-            throw Interpreter::ExpectedTokenError(*currentToken, "READ, WRITE or APPEND");
+            throw Interpreter::ExpectedTokenError(*currentToken, "READ, WRITE, APPEND or RANDOM");
     }
     advance();
 
@@ -71,7 +74,7 @@ Node *Parser::parseReadFile() {
     if (currentToken->type != TokenType::IDENTIFIER)
         throw Interpreter::ExpectedTokenError(*currentToken, "variable");
     
-    Node *readFileNode = create<ReadFileNode>(token, *filename, *currentToken);
+    Node *readFileNode = create<ReadFileNode>(token, *filename, *currentToken, fileSites++);
     advance();
 
     return readFileNode;
@@ -88,7 +91,7 @@ Node *Parser::parseWriteFile() {
     advance();
 
     Node *data = parseEvaluationExpression();
-    Node *writeFileNode = create<WriteFileNode>(token, *filename, *data);
+    Node *writeFileNode = create<WriteFileNode>(token, *filename, *data, fileSites++);
     return writeFileNode;
 }
 
@@ -97,6 +100,65 @@ Node *Parser::parseCloseFile() {
     advance();
 
     Node *filename = parseStringExpression();
-    Node *closeFileNode = create<CloseFileNode>(token, *filename);
+    Node *closeFileNode = create<CloseFileNode>(token, *filename, fileSites++);
     return closeFileNode;
 }
+
+Node *Parser::parseSeek() {
+    const Token &token = *currentToken;
+    advance();
+
+    Node *filename = parseStringExpression();
+
+    if (currentToken->type != TokenType::COMMA)
+        throw Interpreter::ExpectedTokenError(*currentToken, "','");
+    advance();
+
+    Node *address = parseEvaluationExpression();
+    Node *seekNode = create<SeekNode>(token, *filename, *address, fileSites++);
+    return seekNode;
+}
+
+Node *Parser::parseRecord() {
+    const Token &token = *currentToken;
+    advance();
+
+    Node *filename = parseStringExpression();
+
+    if (currentToken->type != TokenType::COMMA)
+        throw Interpreter::ExpectedTokenError(*currentToken, "','");
+    advance();
+
+    if (currentToken->type != TokenType::IDENTIFIER)
+        throw Interpreter::ExpectedTokenError(*currentToken, "variable");
+    auto resolver = parseIdentifierExpression();
+
+    Node *recordNode = create<RecordNode>(token, *filename, *resolver, fileSites++);
+    return recordNode;
+}
+
+Node *Parser::parseLoadCsv() {
+    const Token &token = *currentToken;
+    advance();
+
+    Node *filename = parseStringExpression();
+
+    if (currentToken->type != TokenType::COMMA)
+        throw Interpreter::ExpectedTokenError(*currentToken, "','");
+    advance();
+
+    if (currentToken->type != TokenType::IDENTIFIER)
+        throw Interpreter::ExpectedTokenError(*currentToken, "array");
+    auto array = parseIdentifierExpression();
+
+    AbstractVariableResolver *rowCount = nullptr;
+    if (currentToken->type == TokenType::COMMA) {
+        advance();
+        if (currentToken->type != TokenType::IDENTIFIER)
+            throw Interpreter::ExpectedTokenError(*currentToken, "variable");
+        rowCount = parseIdentifierExpression();
+    }
+
+    Node *loadCsvNode = create<LoadCsvNode>(token, *filename, *array, rowCount);
+    return loadCsvNode;
+}
@@ -0,0 +1,20 @@
+#include "pch.h"
+
+#include "parser/lazyBlock.h"
+#include "parser/parser.h"
+
+LazyBlock::LazyBlock(Parser &parser, std::span<const Token> tokens)
+    : Block({}), parser(parser), tokens(tokens)
+{}
+
+void LazyBlock::parse() {
+    // Bodies with syntax errors aren't marked parsed, so every run reaching them raises the error
+    std::call_once(parsed, [&]() {
+        block = parser.parseDeferredBlock(tokens);
+    });
+}
+
+void LazyBlock::run(Interpreter::Context &ctx) {
+    parse();
+    block->run(ctx);
+}
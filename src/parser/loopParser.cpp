@@ -2,7 +2,35 @@
 
 #include "parser/parser.h"
 
+// Describes the only update a reduced variable allows
+static std::string reducedUpdate(const ParallelForNode::Reduction &reduction) {
+    std::string name(reduction.variable->value);
+    switch (reduction.operation) {
+        case ParallelForNode::Reduction::Operation::SUM:
+        case ParallelForNode::Reduction::Operation::COUNT:
+            return "'" + name + "' is reduced by the PARALLEL FOR loop, it can only be updated with " + name + " <- " + name + " + <value>";
+        case ParallelForNode::Reduction::Operation::MIN:
+            return "'" + name + "' is reduced by the PARALLEL FOR loop, it can only be updated with IF <value> < " + name + " THEN " + name + " <- <value>";
+        case ParallelForNode::Reduction::Operation::MAX:
+            return "'" + name + "' is reduced by the PARALLEL FOR loop, it can only be updated with IF <value> > " + name + " THEN " + name + " <- <value>";
+    }
+    std::abort();
+}
+
+static bool sameTokens(std::span<const Token> a, std::span<const Token> b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const Token &x, const Token &y) {
+        return x.type == y.type && x.value == y.value;
+    });
+}
+
 Node *Parser::parseForLoop() {
+    bool parallel = currentToken->type == TokenType::PARALLEL;
+    if (parallel) {
+        advance();
+        if (currentToken->type != TokenType::FOR)
+            throw Interpreter::ExpectedTokenError(*currentToken, "'FOR'");
+    }
+
     const Token &forToken = *currentToken;
     advance();
 
@@ -31,7 +59,75 @@ Node *Parser::parseForLoop() {
         step = nullptr;
     }
 
-    Interpreter::Block *block = parseBlock();
+    std::vector<ParallelForNode::Reduction> reductions;
+    if (parallel && currentToken->type == TokenType::REDUCE) {
+        do {
+            advance();
+            if (currentToken->type != TokenType::IDENTIFIER)
+                throw Interpreter::ExpectedTokenError(*currentToken, "'SUM', 'COUNT', 'MIN' or 'MAX'");
+
+            ParallelForNode::Reduction reduction;
+            if (currentToken->value == "SUM") reduction.operation = ParallelForNode::Reduction::Operation::SUM;
+            else if (currentToken->value == "COUNT") reduction.operation = ParallelForNode::Reduction::Operation::COUNT;
+            else if (currentToken->value == "MIN") reduction.operation = ParallelForNode::Reduction::Operation::MIN;
+            else if (currentToken->value == "MAX") reduction.operation = ParallelForNode::Reduction::Operation::MAX;
+            else throw Interpreter::ExpectedTokenError(*currentToken, "'SUM', 'COUNT', 'MIN' or 'MAX'");
+            advance();
+
+            if (currentToken->type != TokenType::IDENTIFIER)
+                throw Interpreter::ExpectedTokenError(*currentToken, "identifier");
+            if (currentToken->value == iterator.value)
+                throw Interpreter::SyntaxError(*currentToken, "Cannot REDUCE the PARALLEL FOR loop's iterator");
+            for (const ParallelForNode::Reduction &other : reductions) {
+                if (other.variable->value == currentToken->value)
+                    throw Interpreter::SyntaxError(*currentToken, "'" + std::string(currentToken->value) + "' is already reduced by this loop");
+            }
+            reduction.variable = currentToken;
+            reductions.push_back(reduction);
+            advance();
+        } while (currentToken->type == TokenType::COMMA);
+    }
+
+    Interpreter::Block *block;
+    ParallelBody body{iterator, {}, {}, 0, reductions, {}, nullptr, {}, {}, {}};
+    bool nested = parallelBody != nullptr;
+    if (parallel) {
+        parallelBody = &body;
+        try {
+            block = parseBlock();
+        } catch (...) {
+            parallelBody = nullptr;
+            throw;
+        }
+        parallelBody = nullptr;
+
+        if (!body.reducedUses.empty()) {
+            const Token &use = *body.reducedUses.front();
+            for (const ParallelForNode::Reduction &reduction : reductions) {
+                if (reduction.variable->value == use.value) throw Interpreter::SyntaxError(use, reducedUpdate(reduction));
+            }
+        }
+
+        parallelBody = &body;
+        try {
+            checkParallelReads();
+        } catch (...) {
+            parallelBody = nullptr;
+            throw;
+        }
+        parallelBody = nullptr;
+    } else if (nested) {
+        if (iterator.value == parallelBody->iterator.value)
+            throw Interpreter::SyntaxError(iterator, "Cannot assign to '" + std::string(iterator.value) + "', the PARALLEL FOR loop's iterator");
+        if (findReduction(iterator.value) != nullptr) parallelBody->reducedUses.push_back(&iterator);
+        parallelBody->locals.push_back(iterator.value);
+        parallelBody->loops++;
+        block = parseBlock();
+        parallelBody->loops--;
+        parallelBody->locals.pop_back();
+    } else {
+        block = parseBlock();
+    }
 
     if (currentToken->type != TokenType::NEXT)
         throw Interpreter::ExpectedTokenError(*currentToken, "'NEXT'");
@@ -39,18 +135,220 @@ Node *Parser::parseForLoop() {
 
     if (currentToken->type == TokenType::IDENTIFIER) {
         if (currentToken->value != iterator.value)
-            throw Interpreter::ExpectedTokenError(*currentToken, "'" + iterator.value + "'");
+            throw Interpreter::ExpectedTokenError(*currentToken, "'" + std::string(iterator.value) + "'");
         advance();
     }
 
-    return create<ForLoopNode>(forToken, iterator, *start, *stop, step, block);
+    if (parallel) return create<ParallelForNode>(forToken, iterator, *start, *stop, step, block, arena.copy(body.calls), arena.copy(reductions));
+    return create<ForLoopNode>(forToken, iterator, *start, *stop, step, block, nested);
+}
+
+void Parser::checkParallelStatement() {
+    switch (currentToken->type) {
+        case TokenType::BREAK:
+            if (parallelBody->loops > 0) return;
+            throw Interpreter::SyntaxError(*currentToken, "Cannot BREAK out of a PARALLEL FOR loop");
+        case TokenType::CALL:
+            throw Interpreter::SyntaxError(*currentToken, "Procedures cannot be called in a PARALLEL FOR loop");
+        case TokenType::RETURN:
+            throw Interpreter::SyntaxError(*currentToken, "Cannot RETURN from inside a PARALLEL FOR loop");
+        case TokenType::TYPE:
+            throw Interpreter::SyntaxError(*currentToken, "Types cannot be defined in a PARALLEL FOR loop");
+        case TokenType::PARALLEL:
+            throw Interpreter::SyntaxError(*currentToken, "PARALLEL FOR loops cannot be nested");
+        case TokenType::OUTPUT:
+        case TokenType::READ:
+        case TokenType::INPUT:
+        case TokenType::OPENFILE:
+        case TokenType::READFILE:
+        case TokenType::WRITEFILE:
+        case TokenType::CLOSEFILE:
+        case TokenType::SEEK:
+        case TokenType::GETRECORD:
+        case TokenType::PUTRECORD:
+        case TokenType::LOADCSV:
+            throw Interpreter::SyntaxError(*currentToken, "Input and output are not allowed in a PARALLEL FOR loop");
+        default:
+            return;
+    }
+}
+
+Parser::ParallelAccess Parser::parallelAccess(const Token &token, const AbstractVariableResolver &resolver) const {
+    // Resolvers wrap the one before them, so the chain is collected from the outside in and walked from the variable out
+    std::vector<const AbstractVariableResolver*> chain{&resolver};
+    while (true) {
+        const AbstractVariableResolver *current = chain.back();
+        if (auto *element = dynamic_cast<const ArrayElementResolver*>(current)) chain.push_back(&element->getResolver());
+        else if (auto *composite = dynamic_cast<const CompositeResolver*>(current)) chain.push_back(&composite->getResolver());
+        else if (auto *pointer = dynamic_cast<const PointerDereferencer*>(current)) chain.push_back(&pointer->getResolver());
+        else break;
+    }
+
+    ParallelAccess access;
+    access.token = &token;
+    access.variable = static_cast<const SimpleVariableSource*>(chain.back())->getName();
+    const auto &locals = parallelBody->locals;
+    access.local = std::find(locals.begin(), locals.end(), access.variable) != locals.end();
+
+    std::string slice(access.variable);
+    for (size_t i = chain.size() - 1; i-- > 0; ) {
+        if (auto *element = dynamic_cast<const ArrayElementResolver*>(chain[i])) {
+            std::span<Node *const> indices = element->getIndices();
+            for (size_t position = 0; position < indices.size(); position++) {
+                auto *index = dynamic_cast<const AccessNode*>(indices[position]);
+                auto *indexSource = index != nullptr ? dynamic_cast<const SimpleVariableSource*>(&index->getResolver()) : nullptr;
+                if (indexSource != nullptr && indexSource->getName() == parallelBody->iterator.value) {
+                    access.slice = slice + "[" + std::to_string(position) + "]";
+                    return access;
+                }
+            }
+            slice += "[]";
+        } else if (auto *composite = dynamic_cast<const CompositeResolver*>(chain[i])) {
+            slice += ".";
+            slice += composite->getMember().value;
+        } else {
+            access.dereferenced = true;
+            access.local = false;
+        }
+    }
+    return access;
+}
+
+void Parser::checkParallelAssignment(const Token &token, const AbstractVariableResolver &target) {
+    ParallelAccess access = parallelAccess(token, target);
+    if (access.local) return;
+    if (access.dereferenced)
+        throw Interpreter::SyntaxError(token, "PARALLEL FOR loops cannot assign through pointers, which could point anywhere");
+    if (access.slice.empty())
+        throw Interpreter::SyntaxError(token, "PARALLEL FOR loops can only assign to variables declared inside them or to array elements indexed by '"
+            + std::string(parallelBody->iterator.value) + "'");
+    parallelBody->writes.push_back(std::move(access));
+}
+
+void Parser::addParallelRead(const Token &token, const AbstractVariableResolver &resolver) {
+    ParallelAccess access = parallelAccess(token, resolver);
+    // Reduced variables have checks of their own
+    if (!access.local && (access.dereferenced || findReduction(access.variable) == nullptr)) parallelBody->reads.push_back(std::move(access));
+}
+
+void Parser::checkParallelReads() {
+    auto &writes = parallelBody->writes;
+    std::string iterator(parallelBody->iterator.value);
+    for (const ParallelAccess &write : writes) {
+        for (const ParallelAccess &other : writes) {
+            if (other.variable == write.variable && other.slice != write.slice)
+                throw Interpreter::SyntaxError(*other.token, "Elements of '" + std::string(other.variable)
+                    + "' must be indexed by '" + iterator + "' in the same position everywhere in a PARALLEL FOR loop");
+        }
+    }
+
+    // Reading part of a variable that another iteration assigns to would depend on the order iterations run in
+    for (const ParallelAccess &read : parallelBody->reads) {
+        if (read.dereferenced) {
+            if (!writes.empty())
+                throw Interpreter::SyntaxError(*read.token, "PARALLEL FOR loops that assign to array elements cannot read through pointers, which could point to them");
+            continue;
+        }
+        for (const ParallelAccess &write : writes) {
+            if (write.variable == read.variable && write.slice != read.slice)
+                throw Interpreter::SyntaxError(*read.token, "'" + std::string(read.variable) + "' is assigned to by this PARALLEL FOR loop, "
+                    "so it can only be read through the element indexed by '" + iterator + "' that each iteration assigns to");
+        }
+    }
+}
+
+const ParallelForNode::Reduction *Parser::findReduction(std::string_view name) const {
+    for (const ParallelForNode::Reduction &reduction : parallelBody->reductions) {
+        if (reduction.variable->value == name) return &reduction;
+    }
+    return nullptr;
+}
+
+void Parser::checkReducedAssignment(const Token &token, const ParallelForNode::Reduction &reduction, Node &value, std::span<const Token> valueTokens, size_t uses) {
+    // The first use is the assignment's own target
+    auto &reducedUses = parallelBody->reducedUses;
+    bool allowed = false;
+    switch (reduction.operation) {
+        case ParallelForNode::Reduction::Operation::SUM:
+        case ParallelForNode::Reduction::Operation::COUNT: {
+            // The variable must be one side of the top level addition, and not be used in the other
+            size_t n = valueTokens.size();
+            if (reducedUses.size() != uses + 2 || reducedUses.back()->value != reduction.variable->value || n < 3) break;
+            const Token *use = reducedUses.back();
+            allowed = (use == &valueTokens[0] && &value.getToken() == &valueTokens[1])
+                || (use == &valueTokens[n - 1] && &value.getToken() == &valueTokens[n - 2]);
+            allowed = allowed && value.getToken().type == TokenType::PLUS;
+            break;
+        } case ParallelForNode::Reduction::Operation::MIN:
+        case ParallelForNode::Reduction::Operation::MAX:
+            allowed = reducedUses.size() == uses + 1 && parallelBody->guarded == &reduction && sameTokens(valueTokens, parallelBody->guardedValue);
+            break;
+    }
+
+    if (!allowed) throw Interpreter::SyntaxError(token, reducedUpdate(reduction));
+    reducedUses.resize(uses);
+}
+
+Interpreter::Block *Parser::parseGuardedBlock(Node &condition, std::span<const Token> conditionTokens, size_t uses) {
+    auto &reducedUses = parallelBody->reducedUses;
+    const ParallelForNode::Reduction *reduction = nullptr;
+    std::span<const Token> value;
+
+    // The condition must compare the variable with a value that doesn't use it, on either side
+    size_t n = conditionTokens.size();
+    const Token &op = condition.getToken();
+    if (reducedUses.size() == uses + 1 && n >= 3) {
+        const Token *use = reducedUses.back();
+        bool lesser = op.type == TokenType::LESSER || op.type == TokenType::LESSER_EQUAL;
+        bool greater = op.type == TokenType::GREATER || op.type == TokenType::GREATER_EQUAL;
+        // Whether the condition is true when the value is below the variable, or above it
+        bool below = false, above = false;
+        if (use == &conditionTokens[0] && &op == &conditionTokens[1]) {
+            value = conditionTokens.subspan(2);
+            below = greater;
+            above = lesser;
+        } else if (use == &conditionTokens[n - 1] && &op == &conditionTokens[n - 2]) {
+            value = conditionTokens.first(n - 2);
+            below = lesser;
+            above = greater;
+        }
+
+        reduction = findReduction(use->value);
+        if (reduction != nullptr && ((below && reduction->operation == ParallelForNode::Reduction::Operation::MIN)
+            || (above && reduction->operation == ParallelForNode::Reduction::Operation::MAX))) {
+            reducedUses.pop_back();
+        } else {
+            reduction = nullptr;
+        }
+    }
+
+    const Token *blockStart = currentToken;
+    const ParallelForNode::Reduction *outerGuarded = parallelBody->guarded;
+    std::span<const Token> outerValue = parallelBody->guardedValue;
+    parallelBody->guarded = reduction;
+    parallelBody->guardedValue = value;
+    Interpreter::Block *block = parseBlock();
+    parallelBody->guarded = outerGuarded;
+    parallelBody->guardedValue = outerValue;
+
+    // Anything else in the block would depend on the chunk's own value of the variable, so the assignment must be all there is
+    if (reduction != nullptr) {
+        std::span<const Token> statement(blockStart, currentToken);
+        while (!statement.empty() && statement.front().type == TokenType::LINE_END) statement = statement.subspan(1);
+        while (!statement.empty() && statement.back().type == TokenType::LINE_END) statement = statement.first(statement.size() - 1);
+        if (statement.size() != value.size() + 2 || statement[0].value != reduction->variable->value)
+            throw Interpreter::SyntaxError(condition.getToken(), reducedUpdate(*reduction));
+    }
+    return block;
 }
 
 Node *Parser::parseRepeatLoop() {
     const Token &repeatToken = *currentToken;
     advance();
 
+    if (parallelBody != nullptr) parallelBody->loops++;
     Interpreter::Block *block = parseBlock();
+    if (parallelBody != nullptr) parallelBody->loops--;
 
     if (currentToken->type != TokenType::UNTIL)
         throw Interpreter::ExpectedTokenError(*currentToken, "'UNTIL'");
@@ -70,7 +368,9 @@ Node *Parser::parseWhileLoop() {
     while (currentToken->type == TokenType::LINE_END) advance();
     if (currentToken->type == TokenType::DO) advance();
 
+    if (parallelBody != nullptr) parallelBody->loops++;
     Interpreter::Block *block = parseBlock();
+    if (parallelBody != nullptr) parallelBody->loops--;
 
     if (currentToken->type != TokenType::ENDWHILE)
         throw Interpreter::ExpectedTokenError(*currentToken, "'ENDWHILE'");
@@ -3,7 +3,7 @@
 #include "parser/parser.h"
 
 void Parser::advance() {
-    if (++idx < tokens->size()) currentToken = (*tokens)[idx];
+    if (++idx < tokens.size()) currentToken = &tokens[idx];
 }
 
 Interpreter::DataType Parser::getPSCType() {
@@ -23,20 +23,30 @@ Interpreter::DataType Parser::getPSCType() {
 }
 
 bool Parser::compareNextType(unsigned int n, TokenType type) {
-    if (idx + n >= tokens->size()) return false;
-    return (*tokens)[idx + n]->type == type;
+    if (idx + n >= tokens.size()) return false;
+    return tokens[idx + n].type == type;
 }
 
-Parser::Parser(const std::vector<Token*> *tokens)
+Parser::Parser(std::span<const Token> tokens)
 {
     setTokens(tokens);
 }
 
-void Parser::setTokens(const std::vector<Token*> *_tokens) {
+void Parser::setTokens(std::span<const Token> _tokens) {
     tokens = _tokens;
     idx = SIZE_MAX; // overflow to 0 on advance()
     advance();
-    nodes.reserve(tokens->size() / 2);
+
+    colonAhead.resize(tokens.size());
+    bool colon = false;
+    for (size_t i = tokens.size(); i-- > 0; ) {
+        colonAhead[i] = colon;
+        if (tokens[i].type == TokenType::LINE_END) colon = false;
+        else if (tokens[i].type == TokenType::COLON) colon = true;
+    }
+
+    // Rough estimate of the space the nodes will need, so most programs fit in one chunk
+    arena.reserve(tokens.size() * 32);
 }
 
 Interpreter::Block *Parser::parse() {
@@ -49,12 +59,11 @@ Interpreter::Block *Parser::parse() {
 }
 
 Interpreter::Block *Parser::parseBlock(BlockType blockType) {
-    Interpreter::Block *block;
-    if (blockType == BlockType::MAIN) block = new Interpreter::MainBlock();
-    else block = new Interpreter::Block();
-
-    blocks.emplace_back(block);
+    // Variables declared in a PARALLEL FOR body only count as local until the end of the block declaring them,
+    // after it they may not have been declared at all
+    size_t parallelScope = parallelBody != nullptr ? parallelBody->locals.size() : 0;
 
+    std::vector<Node*> nodes;
     while (true) {
         while (currentToken->type == TokenType::LINE_END) advance();
         if (currentToken->type == TokenType::EXPRESSION_END
@@ -69,18 +78,8 @@ Interpreter::Block *Parser::parseBlock(BlockType blockType) {
             || currentToken->type == TokenType::ENDFUNCTION
         ) break;
 
-        if (blockType == BlockType::CASE && currentToken->type != TokenType::DECLARE) {
-            bool endBlock = false;
-            for (size_t i = 1; i + idx < tokens->size(); i++) {
-                if (compareNextType(i, TokenType::COLON)) {
-                    endBlock = true;
-                    break;
-                } else if (compareNextType(i, TokenType::LINE_END)) {
-                    break;
-                }
-            }
-            if (endBlock) break;
-        }
+        // A line containing a colon starts the next case
+        if (blockType == BlockType::CASE && currentToken->type != TokenType::DECLARE && colonAhead[idx]) break;
 
         Node *node;
         if (currentToken->type == TokenType::PROCEDURE) {
@@ -93,17 +92,72 @@ Interpreter::Block *Parser::parseBlock(BlockType blockType) {
             node = parseExpression();
         }
 
-        block->addNode(node);
+        nodes.push_back(node);
 
         if (currentToken->type != TokenType::LINE_END && currentToken->type != TokenType::EXPRESSION_END) {
             throw Interpreter::SyntaxError(*currentToken);
         }
     }
 
-    return block;
+    if (parallelBody != nullptr) parallelBody->locals.resize(parallelScope);
+
+    // The block and its list of statements are placed after the statements themselves
+    if (blockType == BlockType::MAIN) return arena.make<Interpreter::MainBlock>(arena.copy(nodes));
+    return arena.make<Interpreter::Block>(arena.copy(nodes));
+}
+
+LazyBlock *Parser::skipRoutineBody(TokenType endType, const std::string &expected) {
+    size_t start = idx;
+    while (currentToken->type != endType) {
+        if (currentToken->type == TokenType::EXPRESSION_END)
+            throw Interpreter::ExpectedTokenError(*currentToken, expected);
+        advance();
+    }
+    advance();
+
+    LazyBlock *body = arena.make<LazyBlock>(*this, tokens.subspan(start, idx - start));
+    deferred.push_back(body);
+    return body;
+}
+
+void Parser::parseDeferred() {
+    for (LazyBlock *body : deferred) body->parse();
+}
+
+Interpreter::Block *Parser::parseDeferredBlock(std::span<const Token> body) {
+    std::lock_guard lock(deferredMutex);
+    std::span<const Token> savedTokens = tokens;
+    std::vector<bool> savedColonAhead = std::move(colonAhead);
+    size_t savedIdx = idx;
+
+    auto restore = [&]() {
+        tokens = savedTokens;
+        colonAhead = std::move(savedColonAhead);
+        idx = savedIdx;
+        if (idx < tokens.size()) currentToken = &tokens[idx];
+    };
+
+    try {
+        setTokens(body);
+        Interpreter::Block *block = parseBlock();
+
+        const Token &endToken = body.back();
+        if (currentToken != &endToken) {
+            std::string expected = endToken.type == TokenType::ENDFUNCTION ? "'ENDFUNCTION'" : "'ENDPROCEDURE'";
+            throw Interpreter::ExpectedTokenError(*currentToken, expected);
+        }
+
+        restore();
+        return block;
+    } catch (...) {
+        restore();
+        throw;
+    }
 }
 
 Node *Parser::parseExpression() {
+    if (parallelBody != nullptr) checkParallelStatement();
+
     switch (currentToken->type) {
         case TokenType::DECLARE:
             return parseDeclareExpression();
@@ -120,6 +174,7 @@ Node *Parser::parseExpression() {
         case TokenType::REPEAT:
             return parseRepeatLoop();
         case TokenType::FOR:
+        case TokenType::PARALLEL:
             return parseForLoop();
         case TokenType::CALL:
             return parseCall();
@@ -136,6 +191,13 @@ Node *Parser::parseExpression() {
             return parseWriteFile();
         case TokenType::CLOSEFILE:
             return parseCloseFile();
+        case TokenType::SEEK:
+            return parseSeek();
+        case TokenType::GETRECORD:
+        case TokenType::PUTRECORD:
+            return parseRecord();
+        case TokenType::LOADCSV:
+            return parseLoadCsv();
         case TokenType::RETURN: {
             const Token &returnToken = *currentToken;
             advance();
@@ -9,7 +9,7 @@ Node *Parser::parseCall() {
     if (currentToken->type != TokenType::IDENTIFIER)
         throw Interpreter::ExpectedTokenError(*currentToken, "identifier");
 
-    const std::string &identifier = currentToken->value;
+    std::string_view identifier = currentToken->value;
     advance();
 
     std::vector<Node*> args;
@@ -32,7 +32,7 @@ Node *Parser::parseCall() {
         }
     }
 
-    return create<CallNode>(callToken, identifier, std::move(args));
+    return create<CallNode>(callToken, identifier, arena.copy(args));
 }
 
 Node *Parser::parseProcedure() {
@@ -41,7 +41,7 @@ Node *Parser::parseProcedure() {
 
     if (currentToken->type != TokenType::IDENTIFIER)
         throw Interpreter::ExpectedTokenError(*currentToken, "identifier");
-    const std::string &procedureName = currentToken->value;
+    std::string_view procedureName = currentToken->value;
     advance();
 
     bool byRef = false;
@@ -81,7 +81,7 @@ Node *Parser::parseProcedure() {
 
             if (currentToken->type != TokenType::IDENTIFIER)
                 throw Interpreter::ExpectedTokenError(*currentToken, "identifier or ')'");
-            const std::string &paramName = currentToken->value;
+            std::string_view paramName = currentToken->value;
             advance();
 
             if (currentToken->type == TokenType::COLON) advance();
@@ -113,10 +113,7 @@ Node *Parser::parseProcedure() {
         advance(); // ')'
     }
 
-    Interpreter::Block *block = parseBlock();
-    if (currentToken->type != TokenType::ENDPROCEDURE)
-        throw Interpreter::ExpectedTokenError(*currentToken, "'ENDPROCEDURE'");
-    advance();
+    Interpreter::Block *block = skipRoutineBody(TokenType::ENDPROCEDURE, "'ENDPROCEDURE'");
 
     return create<ProcedureNode>(
         procedureToken,
@@ -6,14 +6,17 @@ Node *Parser::parseIfStatement() {
     const Token &ifToken = *currentToken;
     advance();
 
+    const Token *conditionStart = currentToken;
+    size_t reducedUses = parallelBody != nullptr ? parallelBody->reducedUses.size() : 0;
     Node *condition = parseEvaluationExpression();
+    std::span<const Token> conditionTokens(conditionStart, currentToken);
 
     while (currentToken->type == TokenType::LINE_END) advance();
     if (currentToken->type != TokenType::THEN)
         throw Interpreter::ExpectedTokenError(*currentToken, "'THEN'");
     advance();
 
-    Interpreter::Block *block = parseBlock();
+    Interpreter::Block *block = parallelBody != nullptr ? parseGuardedBlock(*condition, conditionTokens, reducedUses) : parseBlock();
 
     std::vector<IfConditionComponent> components;
     components.emplace_back(condition, *block);
@@ -22,14 +25,17 @@ Node *Parser::parseIfStatement() {
         advance();
         if (currentToken->type == TokenType::IF) {
             advance();
+            conditionStart = currentToken;
+            reducedUses = parallelBody != nullptr ? parallelBody->reducedUses.size() : 0;
             condition = parseEvaluationExpression();
+            conditionTokens = {conditionStart, currentToken};
 
             while (currentToken->type == TokenType::LINE_END) advance();
             if (currentToken->type != TokenType::THEN)
                 throw Interpreter::ExpectedTokenError(*currentToken, "'THEN'");
             advance();
 
-            block = parseBlock();
+            block = parallelBody != nullptr ? parseGuardedBlock(*condition, conditionTokens, reducedUses) : parseBlock();
             components.emplace_back(condition, *block);
         } else {
             block = parseBlock();
@@ -55,7 +61,11 @@ Node *Parser::parseCaseStatement() {
 
     if (currentToken->type != TokenType::IDENTIFIER)
         throw Interpreter::ExpectedTokenError(*currentToken, "IDENTIFIER");
-    AccessNode *variable = create<AccessNode>(*currentToken, std::make_unique<SimpleVariableSource>(*currentToken));
+    AccessNode *variable = create<AccessNode>(*currentToken, *arena.make<SimpleVariableSource>(*currentToken));
+    if (parallelBody != nullptr) {
+        if (findReduction(currentToken->value) != nullptr) parallelBody->reducedUses.push_back(currentToken);
+        addParallelRead(*currentToken, variable->getResolver());
+    }
     advance();
 
     while (currentToken->type == TokenType::LINE_END) advance();
@@ -56,12 +56,10 @@ Node *Parser::parseType() {
 }
 
 Node *Parser::parseComposite(const Token &token, const Token &identifier) {
-    Interpreter::Block *block = new Interpreter::Block();
-    blocks.emplace_back(block);
-
+    std::vector<Node*> nodes;
     while (currentToken->type == TokenType::DECLARE) {
         Node *declareNode = parseDeclareExpression();
-        block->addNode(declareNode);
+        nodes.push_back(declareNode);
 
         if (currentToken->type != TokenType::LINE_END)
             throw Interpreter::ExpectedTokenError(*currentToken, "newline");
@@ -72,5 +70,6 @@ Node *Parser::parseComposite(const Token &token, const Token &identifier) {
         throw Interpreter::ExpectedTokenError(*currentToken, "'ENDTYPE'");
     advance();
 
+    Interpreter::Block *block = arena.make<Interpreter::Block>(arena.copy(nodes));
     return create<CompositeDefineNode>(token, identifier, *block);
 }
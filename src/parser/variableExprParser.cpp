@@ -22,6 +22,13 @@ Node *Parser::parseDeclareExpression() {
         throw Interpreter::ExpectedTokenError(*currentToken, "':'");
     advance();
 
+    if (parallelBody != nullptr) {
+        for (const Token *identifier : identifiers) {
+            if (findReduction(identifier->value) != nullptr) parallelBody->reducedUses.push_back(identifier);
+            parallelBody->locals.push_back(identifier->value);
+        }
+    }
+
     if (currentToken->type == TokenType::ARRAY)
         return parseArrayDeclare(op, identifiers);
 
@@ -72,10 +79,11 @@ Node *Parser::parseConstDeclareExpression() {
     return create<ConstDeclareNode>(op, *value, identifier);
 }
 
-std::unique_ptr<AbstractVariableResolver> Parser::parseIdentifierExpression() {
+AbstractVariableResolver *Parser::parseIdentifierExpression() {
     const Token &identifier = *currentToken;
     advance();
-    std::unique_ptr<AbstractVariableResolver> resolver = std::make_unique<SimpleVariableSource>(identifier);
+    AbstractVariableResolver *resolver = arena.make<SimpleVariableSource>(identifier);
+    if (parallelBody != nullptr && findReduction(identifier.value) != nullptr) parallelBody->reducedUses.push_back(&identifier);
 
     bool resolve = true;
     while (resolve) {
@@ -84,11 +92,11 @@ std::unique_ptr<AbstractVariableResolver> Parser::parseIdentifierExpression() {
                 const Token &token = *currentToken;
                 advance();
 
-                resolver = std::make_unique<CompositeResolver>(token, std::move(resolver), *currentToken);
+                resolver = arena.make<CompositeResolver>(token, *resolver, *currentToken);
                 advance();
                 break;
             } case TokenType::CARET:
-                resolver = std::make_unique<PointerDereferencer>(*currentToken, std::move(resolver));
+                resolver = arena.make<PointerDereferencer>(*currentToken, *resolver);
                 advance();
                 break;
             case TokenType::LSQRBRACKET: {
@@ -107,7 +115,7 @@ std::unique_ptr<AbstractVariableResolver> Parser::parseIdentifierExpression() {
                     throw Interpreter::ExpectedTokenError(*currentToken, "']'");
                 advance();
 
-                resolver = std::make_unique<ArrayElementResolver>(token, std::move(resolver), std::move(indices));
+                resolver = arena.make<ArrayElementResolver>(token, *resolver, arena.copy(indices));
                 break;
             } default:
                 resolve = false;
@@ -0,0 +1,20 @@
+# Runs SOURCE with --inputs over a copy of the .txt files in INPUTS, made in WORK_DIR so the source tree isn't written to,
+# and checks that the .out file written for each input matches the .expected file next to it
+file(REMOVE_RECURSE ${WORK_DIR})
+file(GLOB inputs ${INPUTS}/*.txt)
+file(COPY ${inputs} DESTINATION ${WORK_DIR})
+
+execute_process(COMMAND ${PROGRAM} --inputs ${WORK_DIR} ${SOURCE} RESULT_VARIABLE result)
+if (NOT result EQUAL 0)
+    message(FATAL_ERROR "--inputs exited with ${result}")
+endif()
+
+foreach(input ${inputs})
+    get_filename_component(name ${input} NAME)
+    get_filename_component(stem ${input} NAME_WE)
+    file(READ ${WORK_DIR}/${name}.out output)
+    file(READ ${INPUTS}/${stem}.expected expected)
+    if (NOT output STREQUAL expected)
+        message(FATAL_ERROR "Output for ${name} was:\n${output}\nexpected:\n${expected}")
+    endif()
+endforeach()